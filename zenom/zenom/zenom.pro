@@ -5,5 +5,6 @@ SUBDIRS += \
     znm-math \
     znm-core \
     znm-controlbase \
+    znm-bench \
     zenom \
     znm-project
@@ -17,6 +17,7 @@ CameraScene::CameraScene(QWidget *parent) :
     QDialog(parent),
     ui(new Ui::CameraScene),
     finish(false),
+    mImageChanged(true),
     mWidth(240),
     mHeight(240),
     mResolution(0),
@@ -47,6 +48,9 @@ CameraScene::~CameraScene()
 
 void CameraScene::tick()
 {
+    if ( !mImageChanged.exchange(false) )
+        return;
+
     std::lock_guard<std::mutex> lock(imgMutex);
     
     ui->label_camera->setPixmap(QPixmap::fromImage(
@@ -123,6 +127,7 @@ void CameraScene::processFrameAndUpdateGUI()
             std::lock_guard<std::mutex> lock(imgMutex);
             lastImage = QImage((const uchar*)(buffer.data()),
                                width, height, width*layer, QImage::Format_RGB888).copy();
+            mImageChanged = true;
         }
 
     }
@@ -202,6 +207,7 @@ void CameraScene::on_tenHund_clicked()
     mWidth=160;
     mHeight=120;
     mResolution=0;
+    mImageChanged=true;
 }
 
 void CameraScene::on_threeHund_clicked()
@@ -209,6 +215,7 @@ void CameraScene::on_threeHund_clicked()
     mWidth=320;
     mHeight=240;
     mResolution=1;
+    mImageChanged=true;
 }
 
 void CameraScene::on_sixHund_clicked()
@@ -216,6 +223,7 @@ void CameraScene::on_sixHund_clicked()
     mWidth=640;
     mHeight=480;
     mResolution=2;
+    mImageChanged=true;
 }
 
 void CameraScene::on_tenThnd_clicked()
@@ -223,6 +231,7 @@ void CameraScene::on_tenThnd_clicked()
     mWidth=1280;
     mHeight=960;
     mResolution=3;
+    mImageChanged=true;
 }
 
 void CameraScene::on_up_clicked()
@@ -24,6 +24,7 @@ public:
 
     ~CameraScene();
 
+    /** Shows the last received image if it changed. */
     void tick();
 
 public slots:
@@ -62,6 +63,7 @@ private:
     quint16 senderPort;
     QImage lastImage;
     std::atomic<bool> finish;
+    std::atomic<bool> mImageChanged;    // tick() redraws only new images
     int mWidth;
     int mHeight;
     int mResolution;
@@ -3,6 +3,7 @@
 
 #include <QHeaderView>
 #include <QEvent>
+#include <QStringList>
 
 ControlVariablesWidget::ControlVariablesWidget(QWidget *parent) :
     QWidget(parent, Qt::Window),
@@ -15,6 +16,10 @@ ControlVariablesWidget::ControlVariablesWidget(QWidget *parent) :
     mToggleViewAction->setText( windowTitle() );
     connect(mToggleViewAction, SIGNAL(triggered(bool)), SLOT(toggleView(bool)));
 
+    mModel = new ControlVariableModel(this);
+    ui->controlVariableTable->setModel(mModel);
+    connect(mModel, SIGNAL(pendingValuesChanged(bool)), SLOT(enableButtons(bool)));
+
     enableButtons(false);
 }
 
@@ -26,88 +31,23 @@ ControlVariablesWidget::~ControlVariablesWidget()
 
 void ControlVariablesWidget::setControlVariableList( const ControlVariableList& pControlVariableList )
 {
-    ui->controlVariableTable->setRowCount( pControlVariableList.size() );
-
-    ControlVariable* controlVariable;
-    unsigned int maxColSize = 100;
-
-    for ( unsigned int i = 0; i < pControlVariableList.size(); ++i )
-    {
-        controlVariable = pControlVariableList[i];
-
-        QTableWidgetItem* name = new QTableWidgetItem( QString::fromStdString(controlVariable->name()) );
-        name->setFlags( Qt::ItemIsEnabled );
-        ui->controlVariableTable->setItem(i, 0, name);
-
-        // Value Table
-        QTableWidget* valueTable = new QTableWidget(controlVariable->row(), controlVariable->col());
-        valueTable->horizontalHeader()->setDefaultSectionSize(60);
-        valueTable->horizontalHeader()->hide();
-        valueTable->verticalHeader()->hide();
-        connect(valueTable, SIGNAL(itemChanged(QTableWidgetItem*)), SLOT(itemChanged(QTableWidgetItem*)) );
-
-        for ( unsigned int row = 0; row < controlVariable->row(); ++row )
-        {
-            for ( unsigned int col = 0; col < controlVariable->col(); ++col )
-            {
-				QTableWidgetItem* item = new QTableWidgetItem( QString::number(controlVariable->heapElement(row, col) ) );
-				item->setData( Qt::UserRole, i );
-                valueTable->setItem( row, col, item );
-            }
-        }
-
-        ui->controlVariableTable->setCellWidget(i, 1, valueTable );
-        ui->controlVariableTable->verticalHeader()->resizeSection(i, controlVariable->row() * valueTable->verticalHeader()->defaultSectionSize() + 5 );
-
-        maxColSize = qMax( maxColSize, controlVariable->col() * valueTable->horizontalHeader()->defaultSectionSize() );
-    }
-
-    // resize "Value" column
-    ui->controlVariableTable->horizontalHeader()->resizeSection( 1, maxColSize + 5 );
-
-    // Disable apply and cancel buttons
-    enableButtons(false);
+    // Rows and values are created by the view when they are shown.
+    mModel->setControlVariableList( pControlVariableList );
 }
 
 void ControlVariablesWidget::clear()
 {
-    ui->controlVariableTable->clearContents();
-    ui->controlVariableTable->setRowCount(0);
+    mModel->setControlVariableList( ControlVariableList() );
 }
 
 void ControlVariablesWidget::on_apply_clicked()
 {
-    widgetToHeap();
-    enableButtons(false);
+    mModel->applyValues();
 }
 
 void ControlVariablesWidget::on_cancel_clicked()
 {
-    heapToWidget();
-    enableButtons(false);
-}
-
-void ControlVariablesWidget::itemChanged(QTableWidgetItem* pItem)
-{
-    bool ok;
-    pItem->text().toDouble( &ok );
-	// Gecersiz deger girilirse heap'te yer alan deger tekrar yazilir.
-    if ( ok )
-    {		
-        enableButtons(true);
-    }
-    else
-    {		
-		int index = pItem->data( Qt::UserRole ).toInt();
-		int row = pItem->row();
-		int column = pItem->column();
-		
-        ControlVariable* controlVariable =
-                DataRepository::instance()->controlVariables()[index];
-        QTableWidget* tableWidget =
-                (QTableWidget*)ui->controlVariableTable->cellWidget(index, 1);
-		tableWidget->item( row, column )->setText( QString::number(controlVariable->heapElement(row, column)) );
-    }
+    mModel->discardValues();
 }
 
 void ControlVariablesWidget::enableButtons(bool pEnable)
@@ -116,65 +56,29 @@ void ControlVariablesWidget::enableButtons(bool pEnable)
     ui->cancel->setEnabled(pEnable);
 }
 
-void ControlVariablesWidget::heapToWidget()
-{
-    ControlVariable* controlVariable;
-    ControlVariableList controlVariableList = DataRepository::instance()->controlVariables();
-    for ( unsigned int i = 0; i < controlVariableList.size(); ++i )
-    {
-        QTableWidget* tableWidget = (QTableWidget*)ui->controlVariableTable->cellWidget(i, 1);
-        controlVariable = controlVariableList[i];
-
-        for ( unsigned int row = 0; row < controlVariable->row(); ++row )
-        {
-            for ( unsigned int col = 0; col < controlVariable->col(); ++col )
-            {
-                tableWidget->item(row, col)->setText( QString::number(controlVariable->heapElement(row, col)) );
-            }
-        }
-    }
-}
-
-void ControlVariablesWidget::widgetToHeap()
-{
-    ControlVariable* controlVariable;
-    ControlVariableList controlVariableList = DataRepository::instance()->controlVariables();
-    for ( unsigned int i = 0; i < controlVariableList.size(); ++i )
-    {
-        QTableWidget* tableWidget = (QTableWidget*)ui->controlVariableTable->cellWidget(i, 1);
-        controlVariable = controlVariableList[i];
-
-        for ( unsigned int row = 0; row < controlVariable->row(); ++row )
-        {
-            for ( unsigned int col = 0; col < controlVariable->col(); ++col )
-            {
-                double val = tableWidget->item(row, col)->text().toDouble();
-                controlVariable->setHeapElement(row, col, val);
-            }
-        }
-    }
-}
-
 void ControlVariablesWidget::saveSettings( QSettings& pSettings )
 {
     pSettings.beginGroup("controlVariablesWidget");
     pSettings.setValue("geometry", saveGeometry());
     pSettings.setValue("visible", isVisible());
 
+	// Her degiskenin degerleri satir satir tek bir listede saklanir.
 	ControlVariable* controlVariable;
 	ControlVariableList controlVariableList = DataRepository::instance()->controlVariables();
 	for ( unsigned int i = 0; i < controlVariableList.size(); ++i )
 	{
 		controlVariable = controlVariableList[i];
 
-		pSettings.beginGroup(ui->controlVariableTable->item(i, 0)->text());
-		for ( unsigned int row = 0; row < controlVariable->row(); ++row )
+		QStringList values;
+		values.reserve( controlVariable->size() );
+		for ( unsigned int j = 0; j < controlVariable->size(); ++j )
 		{
-			for ( unsigned int col = 0; col < controlVariable->col(); ++col )
-			{
-				pSettings.setValue( QString("value[%1][%2]").arg(row).arg(col), controlVariable->heapElement(row, col));
-			}
+			values.push_back( QString::number(controlVariable->heapElement(j), 'g', 17) );
 		}
+
+		pSettings.beginGroup(QString::fromStdString(controlVariable->name()));
+		pSettings.remove("");
+		pSettings.setValue("values", values);
 		pSettings.endGroup();
 	}
 	pSettings.endGroup();
@@ -190,25 +94,41 @@ void ControlVariablesWidget::loadSettings(QSettings &pSettings)
 	ControlVariableList controlVariableList = DataRepository::instance()->controlVariables();
 	for ( unsigned int i = 0; i < controlVariableList.size(); ++i )
 	{
-		QTableWidget* tableWidget = (QTableWidget*)ui->controlVariableTable->cellWidget(i, 1);
 		controlVariable = controlVariableList[i];
 
-		pSettings.beginGroup(ui->controlVariableTable->item(i, 0)->text());
-		for ( unsigned int row = 0; row < controlVariable->row(); ++row )
+		pSettings.beginGroup(QString::fromStdString(controlVariable->name()));
+		if ( pSettings.contains("values") )
+		{
+			// Boyutu degisen degiskenin yalnizca ortak elemanlari yuklenir.
+			const QStringList values = pSettings.value("values").toStringList();
+			const int count = qMin( values.size(), (int)controlVariable->size() );
+			for ( int j = 0; j < count; ++j )
+			{
+				bool ok;
+				double val = values[j].toDouble( &ok );
+				if ( ok )
+					controlVariable->setHeapElement( j, val );
+			}
+		}
+		else
 		{
-			for ( unsigned int col = 0; col < controlVariable->col(); ++col )
-            {
-                double defaultValue = controlVariable->heapElement(row, col);
-                double val = pSettings.value( QString("value[%1][%2]").arg(row).arg(col), defaultValue ).toDouble();
-				controlVariable->setHeapElement( row, col, val );
-				tableWidget->item( row, col )->setText( QString::number(val) );
+			// Eski ayar dosyalari her elemani ayri anahtarda saklar.
+			for ( unsigned int row = 0; row < controlVariable->row(); ++row )
+			{
+				for ( unsigned int col = 0; col < controlVariable->col(); ++col )
+				{
+					double defaultValue = controlVariable->heapElement(row, col);
+					double val = pSettings.value( QString("value[%1][%2]").arg(row).arg(col), defaultValue ).toDouble();
+					controlVariable->setHeapElement( row, col, val );
+				}
 			}
 		}
 		pSettings.endGroup();
 	}
     pSettings.endGroup();
 
-	enableButtons(false);
+	DataRepository::instance()->commitControlVariables();
+	mModel->discardValues();
 }
 
 QAction* ControlVariablesWidget::toggleViewAction() const
@@ -2,10 +2,10 @@
 #define CONTROLVARIABLESWIDGET_H
 
 #include <QWidget>
-#include <QTableWidgetItem>
 #include <QSettings>
 
 #include <datarepository.h>
+#include "widget/controlvariablemodel.h"
 
 namespace Ui {
 class ControlVariablesWidget;
@@ -35,17 +35,13 @@ protected:
 private slots:
     void on_apply_clicked();
     void on_cancel_clicked();
-    void itemChanged(QTableWidgetItem* pItem);
+    void enableButtons(bool pEnable);
     void toggleView(bool pChecked);
 
-private:
-    void enableButtons(bool pEnable);
-    void heapToWidget();
-    void widgetToHeap();
-    
 private:
     Ui::ControlVariablesWidget *ui;
     QAction* mToggleViewAction;
+    ControlVariableModel* mModel;
 };
 
 #endif // CONTROLVARIABLESWIDGET_H
@@ -1,4 +1,5 @@
 #include "abstractgauge.h"
+#include <QWidget>
 
 AbstractGauge::AbstractGauge()
 {
@@ -20,6 +21,11 @@ void AbstractGauge::setTitle( const QString& pTitle )
 	mTitle = pTitle;
 }
 
+void AbstractGauge::setStatistics( const RunningStatistics& pStatistics )
+{
+	asWidget()->setToolTip( pStatistics.toString() );
+}
+
 void AbstractGauge::saveSettings( QSettings& pSettings )
 {
 	pSettings.setValue("title", title()); 
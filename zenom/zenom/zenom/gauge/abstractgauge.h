@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QSettings>
+#include "widget/runningstatistics.h"
 
 enum GaugeType
 {
@@ -21,6 +22,9 @@ public:
 	virtual GaugeType type() = 0;
 
 	virtual void setValue( double pValue ) = 0;
+
+	/** Statistics of the run so far, shown as the tool tip by default */
+	virtual void setStatistics( const RunningStatistics& pStatistics );
 	
 	virtual void saveSettings( QSettings& pSettings );
 
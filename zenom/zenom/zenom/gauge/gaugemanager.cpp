@@ -1,4 +1,5 @@
 #include "gaugemanager.h"
+#include "utility/tickprofiler.h"
 
 
 GaugeManager::GaugeManager(QWidget *parent) :
@@ -45,11 +46,12 @@ void GaugeManager::loadSettings( QSettings& pSettings )
     pSettings.endGroup();
 }
 
-void GaugeManager::tick()
+void GaugeManager::tick( const RefreshScheduler& pScheduler )
 {
     for ( int i = 0; i < mGaugeList.size(); ++i )
     {
-        mGaugeList[i]->tick();
+        TickProfiler::Scope scope( mGaugeList[i]->tickSection() );
+        mGaugeList[i]->tick( pScheduler );
     }
 }
 
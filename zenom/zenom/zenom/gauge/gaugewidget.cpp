@@ -3,20 +3,28 @@
 
 #include <QContextMenuEvent>
 #include <QMenu>
+#include <QInputDialog>
 
 #include "lineargauge.h"
 #include "radialgauge.h"
 #include "numericgauge.h"
 #include "editgaugedialog.h"
+#include "utility/tickprofiler.h"
+#include <datarepository.h>
 
 #include<iostream>
 
 GaugeWidget::GaugeWidget(QWidget *parent) :
     QWidget(parent, Qt::Window | Qt::WindowCloseButtonHint ),
-    ui(new Ui::GaugeWidget)
+    ui(new Ui::GaugeWidget),
+    mRefreshRate(60)
 {
     ui->setupUi(this);
+    updateProfilerSections();
     mGauge = NULL;
+    mHeapGeneration = 0;
+    mLastWriteSequence = 0;
+    mDirty = true;
     setWindowTitle("Gauge");
 }
 
@@ -39,13 +47,58 @@ void GaugeWidget::setGauge( AbstractGauge* pGauge )
     setWindowTitle( pGauge->title() );
     layout()->addWidget( w );
     resize( w->sizeHint() );
+    mDirty = true;
 }
 
-void GaugeWidget::tick()
+void GaugeWidget::tick( const RefreshScheduler& pScheduler )
 {
     if ( mLogVariableItem.isValid() )
     {
+        // Every start creates a new heap, whose sequence numbers may
+        // already be past the last one seen from the old heap.
+        const uint64_t heapGeneration = DataRepository::instance()->logHeapGeneration();
+        if ( heapGeneration != mHeapGeneration )
+        {
+            mStatistics.clear();
+            mLastWriteSequence = 0;
+            mHeapGeneration = heapGeneration;
+            mGauge->setStatistics( mStatistics );
+            mDirty = true;
+        }
+
+        LogVariable* logVariable = mLogVariableItem.logVariable();
+        const uint64_t writeSequence = logVariable->writeSequence();
+        if ( writeSequence == mLastWriteSequence && !mDirty )
+            return;
+
+        if ( !mRefreshRate.isDue( pScheduler.now() ) )
+            return;
+
         mGauge->setValue( mLogVariableItem.lastHeapElement() );
+        mDirty = false;
+
+        // Only the samples written since the last tick are added. A ring
+        // heap may wrap during a copy; the overwritten samples are dropped,
+        // the statistics cannot be corrected later.
+        if ( writeSequence != mLastWriteSequence )
+        {
+            const uint64_t BLOCK_SIZE = 4096;
+            uint64_t sequence = qMax( mLastWriteSequence, logVariable->firstSequence() );
+            while ( sequence < writeSequence )
+            {
+                const uint64_t count = qMin( writeSequence - sequence, BLOCK_SIZE );
+                mLogVariableItem.copyHeapSamples( sequence, count, mSamples );
+                const uint64_t intact = qMin( logVariable->firstIntactSequence( sequence ),
+                                              sequence + count );
+                for ( uint64_t i = intact - sequence; i < count; ++i )
+                {
+                    mStatistics.add( mSamples[i].y() );
+                }
+                sequence += count;
+            }
+            mLastWriteSequence = writeSequence;
+            mGauge->setStatistics( mStatistics );
+        }
     }
 }
 
@@ -55,6 +108,7 @@ void GaugeWidget::saveSettings( QSettings& pSettings )
     pSettings.setValue("type", mGauge->type());
     mGauge->saveSettings( pSettings );
     mLogVariableItem.saveSettings( pSettings );
+    pSettings.setValue("refreshRate", mRefreshRate.rate());
 }
 
 void GaugeWidget::loadSettings( QSettings& pSettings )
@@ -78,6 +132,10 @@ void GaugeWidget::loadSettings( QSettings& pSettings )
     setGauge( gauge );
     restoreGeometry( pSettings.value("geometry").toByteArray() );
     mLogVariableItem.loadSettings( pSettings );
+    mRefreshRate.setRate( pSettings.value("refreshRate", 60).toInt() );
+    mStatistics.clear();
+    mLastWriteSequence = 0;
+    mDirty = true;
     setWindowTitle( mLogVariableItem.name() );
 }
 
@@ -89,19 +147,32 @@ LogVariableItem GaugeWidget::logVariable()
 void GaugeWidget::setLogVariable( const LogVariableItem& pLogVariableItem )
 {
     mLogVariableItem = pLogVariableItem;
+    mStatistics.clear();
+    mLastWriteSequence = 0;
+    mDirty = true;
     setWindowTitle( pLogVariableItem.name() );
 }
 
 void GaugeWidget::contextMenuEvent( QContextMenuEvent *pEvent )
 {
     QMenu menu;
-    menu.addAction("Edit...");
+    QAction *editAction = menu.addAction("Edit...");
+    QAction *rateAction = menu.addAction("Refresh Rate...");
     QAction *action = menu.exec( pEvent->globalPos() );
-    if ( action )
+    if ( action == editAction )
     {     
         EditGaugeDialog editGaugeDialog;
         editGaugeDialog.initFrom(this);
         editGaugeDialog.exec();
+        mDirty = true;
+    }
+    else if ( action == rateAction )
+    {
+        bool isAccepted;
+        int rate = QInputDialog::getInt( this, "Refresh Rate", "Refresh Rate [Hz]",
+                                         mRefreshRate.rate(), 1, 60, 1, &isAccepted );
+        if ( isAccepted )
+            mRefreshRate.setRate( rate );
     }
 
     QWidget::contextMenuEvent(pEvent);
@@ -112,3 +183,20 @@ void GaugeWidget::closeEvent(QCloseEvent *pEvent)
     emit closed( this );
     QWidget::closeEvent( pEvent );
 }
+
+bool GaugeWidget::event(QEvent *pEvent)
+{
+    if ( pEvent->type() == QEvent::WindowTitleChange )
+        updateProfilerSections();
+
+    // The window paints its dirty children when it handles an update request.
+    TickProfiler::Scope scope( pEvent->type() == QEvent::UpdateRequest ?
+                                   mPaintSection : QString() );
+    return QWidget::event( pEvent );
+}
+
+void GaugeWidget::updateProfilerSections()
+{
+    mTickSection = QString("gauge %1").arg( windowTitle() );
+    mPaintSection = QString("gauge %1 paint").arg( windowTitle() );
+}
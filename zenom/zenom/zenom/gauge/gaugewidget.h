@@ -4,6 +4,7 @@
 #include <QWidget>
 #include "abstractgauge.h"
 #include "widget/logvariableitem.h"
+#include "utility/refreshscheduler.h"
 
 namespace Ui {
 class GaugeWidget;
@@ -22,7 +23,8 @@ public:
 
     void setGauge( AbstractGauge* pGauge );
 
-    void tick();
+    /** Redraws the gauge if it is due and its variable changed. */
+    void tick( const RefreshScheduler& pScheduler );
 
     void saveSettings( QSettings& pSettings );
 
@@ -32,17 +34,34 @@ public:
 
     void setLogVariable( const LogVariableItem& pLogVariableItem );
 
+    /** TickProfiler section of tick(), follows the window title */
+    const QString& tickSection() const { return mTickSection; }
+
 signals:
     void closed( GaugeWidget* ) ;
 
 protected:
     virtual void contextMenuEvent(QContextMenuEvent *pEvent);
     virtual void closeEvent(QCloseEvent *pEvent);
+    virtual bool event(QEvent *pEvent);
 
 private:
     Ui::GaugeWidget *ui;
     AbstractGauge* mGauge;
     LogVariableItem mLogVariableItem;
+
+    RunningStatistics mStatistics;
+    uint64_t mHeapGeneration;   // DataRepository::logHeapGeneration()
+    uint64_t mLastWriteSequence;
+    QPolygonF mSamples;     // new samples of the statistics
+
+    RefreshRate mRefreshRate;
+    bool mDirty;    // gauge or variable changed since the last draw
+
+    QString mTickSection;
+    QString mPaintSection;
+
+    void updateProfilerSections();
 };
 
 #endif // GAUGEWIDGET_H
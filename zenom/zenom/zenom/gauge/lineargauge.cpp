@@ -1,4 +1,6 @@
 #include "lineargauge.h"
+#include <QPainter>
+#include <QStringList>
 
 LinearGauge::LinearGauge(QWidget *pParent)
 	: QwtThermo(pParent)
@@ -112,6 +114,7 @@ void LinearGauge::setTextColor( const QColor& pColor )
 	QPalette& p = (QPalette&)palette();
 	p.setColor(QPalette::All, QPalette::Text, pColor);
 	p.setColor(QPalette::All, QPalette::WindowText, pColor);
+	mStaticLayer.invalidate();
 }
 
 QColor LinearGauge::textColor()
@@ -123,6 +126,7 @@ void LinearGauge::setBackgroundColor( const QColor& pColor )
 {
 	QPalette& p = (QPalette&)palette();
 	p.setColor( QPalette::Base, pColor );
+	mStaticLayer.invalidate();
 }
 
 QColor LinearGauge::backgroundColor()
@@ -134,3 +138,37 @@ QwtScaleDraw * LinearGauge::scaleDraw()
 {
 	return QwtThermo::scaleDraw();
 }
+
+void LinearGauge::paintEvent( QPaintEvent* pEvent )
+{
+	if ( mStaticLayer.isRendering() )
+	{
+		QwtThermo::paintEvent( pEvent );
+		return;
+	}
+
+	mStaticLayer.update( this, staticLayerKey() );
+
+	// drawThermo() fills the whole pipe, covering the cached one.
+	QPainter painter( this );
+	mStaticLayer.draw( &painter );
+	drawThermo( &painter );
+}
+
+QString LinearGauge::staticLayerKey()
+{
+	QStringList key;
+	key << QString::number( palette().cacheKey() )
+		<< font().key()
+		<< QString::number( isEnabled() )
+		<< QString::number( mOrientation )
+		<< QString::number( scalePosition() )
+		<< QString::number( minValue() )
+		<< QString::number( maxValue() )
+		<< QString::number( scaleMaxMajor() )
+		<< QString::number( scaleMaxMinor() )
+		<< QString::number( scaleDraw()->hasComponent( QwtAbstractScaleDraw::Labels ) )
+		<< QString::number( pipeWidth() )
+		<< QString::number( borderWidth() );
+	return key.join( "|" );
+}
@@ -4,6 +4,7 @@
 #include "abstractgauge.h"
 #include <qwt_thermo.h>
 #include <qwt_scale_draw.h>
+#include "staticlayer.h"
 
 class LinearGauge : public QwtThermo, public AbstractGauge
 {
@@ -36,8 +37,16 @@ public:
 	// Why protected ?
 	QwtScaleDraw *scaleDraw();
 
+protected:
+	/** Blits the cached scale and frame and draws only the pipe. */
+	virtual void paintEvent( QPaintEvent* pEvent );
+
 private:
+	/** Settings that change the scale or the frame of the pipe */
+	QString staticLayerKey();
+
 	Qt::Orientation mOrientation;
+	StaticLayer mStaticLayer;
 };
 
 #endif // LINEARGAUGE_H
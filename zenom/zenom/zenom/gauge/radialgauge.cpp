@@ -1,8 +1,13 @@
 #include "radialgauge.h"
 #include <qwt_dial_needle.h>
+#include <QPainter>
+#include <QStringList>
 
 RadialGauge::RadialGauge(QWidget *pParent)
 	: QwtDial(pParent)
+	, mNeedleValid(false)
+	, mNeedleRadius(0)
+	, mNeedleColorGroup(QPalette::Active)
 {
 	setReadOnly( true );
 	setOrigin( 135.0 );
@@ -153,6 +158,7 @@ void RadialGauge::setTextColor( const QColor& pColor )
 {	
 	QPalette& p = (QPalette&)palette();
 	p.setColor(QPalette::All, QPalette::Text, pColor);
+	mStaticLayer.invalidate();
 }
 
 QColor RadialGauge::textColor()
@@ -169,6 +175,7 @@ void RadialGauge::setBackgroundColor( const QColor& pColor )
 	p.setColor( QPalette::Light, pColor.light( 170 ) );
 	p.setColor( QPalette::Dark, pColor.dark( 170 ) );
 	p.setColor( QPalette::WindowText, pColor );
+	mStaticLayer.invalidate();
 }
 
 QColor RadialGauge::backgroundColor()
@@ -192,3 +199,80 @@ int RadialGauge::scaleMaxMinor()
 {
 	return mScaleMaxMinor;
 }
+
+void RadialGauge::paintEvent( QPaintEvent* pEvent )
+{
+	if ( mStaticLayer.isRendering() || mode() == RotateScale )
+	{
+		QwtDial::paintEvent( pEvent );
+		return;
+	}
+
+	mStaticLayer.update( this, staticLayerKey() );
+
+	QPainter painter( this );
+	mStaticLayer.draw( &painter );
+	if ( mNeedleValid && isValid() )
+	{
+		painter.setRenderHint( QPainter::Antialiasing, true );
+		QwtDial::drawNeedle( &painter, mNeedleCenter, mNeedleRadius,
+			needleDirection(), mNeedleColorGroup );
+	}
+}
+
+void RadialGauge::drawNeedle( QPainter* pPainter, const QPointF& pCenter,
+	double pRadius, double pDirection, QPalette::ColorGroup pColorGroup ) const
+{
+	if ( mStaticLayer.isRendering() )
+	{
+		// Left out of the face, drawn on each paint.
+		mNeedleValid = true;
+		mNeedleCenter = pCenter;
+		mNeedleRadius = pRadius;
+		mNeedleColorGroup = pColorGroup;
+		return;
+	}
+
+	QwtDial::drawNeedle( pPainter, pCenter, pRadius, pDirection, pColorGroup );
+}
+
+QString RadialGauge::staticLayerKey() const
+{
+	QStringList key;
+	key << QString::number( palette().cacheKey() )
+		<< font().key()
+		<< QString::number( isEnabled() )
+		<< QString::number( origin() )
+		<< QString::number( minScaleArc() )
+		<< QString::number( maxScaleArc() )
+		<< QString::number( minValue() )
+		<< QString::number( maxValue() )
+		<< QString::number( QwtDial::direction() )
+		<< QString::number( mScaleMaxMajor )
+		<< QString::number( mScaleMaxMinor )
+		<< QString::number( scaleDraw()->hasComponent( QwtAbstractScaleDraw::Labels ) )
+		<< QString::number( lineWidth() )
+		<< QString::number( frameShadow() );
+	return key.join( "|" );
+}
+
+double RadialGauge::needleDirection() const
+{
+	double direction = minScaleArc();
+	if ( maxValue() > minValue() && maxScaleArc() > minScaleArc() )
+	{
+		const double ratio = ( value() - minValue() ) / ( maxValue() - minValue() );
+		direction += ratio * ( maxScaleArc() - minScaleArc() );
+	}
+
+	if ( QwtDial::direction() == QwtDial::CounterClockwise )
+		direction = maxScaleArc() - ( direction - minScaleArc() );
+
+	direction += origin();
+	if ( direction >= 360.0 )
+		direction -= 360.0;
+	else if ( direction < 0.0 )
+		direction += 360.0;
+
+	return direction;
+}
@@ -3,6 +3,7 @@
 
 #include <qwt_dial.h>
 #include "abstractgauge.h"
+#include "staticlayer.h"
 
 class RadialGauge : public QwtDial, public AbstractGauge
 {
@@ -54,7 +55,20 @@ public:
 	void setBackgroundColor( const QColor& pColor );
 	QColor backgroundColor();
 
+protected:
+	/** Blits the cached face and draws only the needle. */
+	virtual void paintEvent( QPaintEvent* pEvent );
+
+	virtual void drawNeedle( QPainter* pPainter, const QPointF& pCenter,
+		double pRadius, double pDirection, QPalette::ColorGroup pColorGroup ) const;
+
 private:
+	/** Settings that change the face of the dial */
+	QString staticLayerKey() const;
+
+	/** Needle direction of the current value, as computed by QwtDial */
+	double needleDirection() const;
+
 	// Ticks
 	int mScaleMaxMajor;
 	int mScaleMaxMinor;
@@ -64,6 +78,13 @@ private:
 	NeedleStyle mNeedleStyle;
 	QColor mNeedleColor1;
 	QColor mNeedleColor2;
+
+	// Face cache, the needle geometry is recorded while it is rendered.
+	StaticLayer mStaticLayer;
+	mutable bool mNeedleValid;
+	mutable QPointF mNeedleCenter;
+	mutable double mNeedleRadius;
+	mutable QPalette::ColorGroup mNeedleColorGroup;
 };
 
 #endif // RADIALGAUGE_H
@@ -0,0 +1,41 @@
+#include "staticlayer.h"
+
+#include <QWidget>
+#include <QPainter>
+
+StaticLayer::StaticLayer()
+    : mRendering( false )
+{
+
+}
+
+void StaticLayer::update( QWidget* pWidget, const QString& pKey )
+{
+    if ( !mPixmap.isNull() && mPixmap.size() == pWidget->size() && mKey == pKey )
+        return;
+
+    mKey = pKey;
+    mPixmap = QPixmap( pWidget->size() );
+    mPixmap.fill( Qt::transparent );
+
+    // render() calls the paint event of the widget with a painter on the
+    // pixmap; the gauge checks isRendering() to paint the static parts.
+    mRendering = true;
+    pWidget->render( &mPixmap );
+    mRendering = false;
+}
+
+void StaticLayer::invalidate()
+{
+    mPixmap = QPixmap();
+}
+
+bool StaticLayer::isRendering() const
+{
+    return mRendering;
+}
+
+void StaticLayer::draw( QPainter* pPainter ) const
+{
+    pPainter->drawPixmap( 0, 0, mPixmap );
+}
@@ -0,0 +1,40 @@
+#ifndef STATICLAYER_H
+#define STATICLAYER_H
+
+#include <QPixmap>
+#include <QString>
+
+class QWidget;
+class QPainter;
+
+/**
+ * Cached image of the parts of a gauge that do not depend on its value
+ * (face, scale, labels and frame). The gauge renders itself into the
+ * layer with the dynamic parts left out, then each paint event only
+ * blits the layer and draws the needle or bar on top.
+ *
+ * The layer is rendered again when the widget size or the key changes;
+ * the key is built by the gauge from the settings that affect the face.
+ */
+class StaticLayer
+{
+public:
+    StaticLayer();
+
+    /** Renders pWidget into the layer if its size or pKey changed. */
+    void update( QWidget* pWidget, const QString& pKey );
+
+    void invalidate();
+
+    /** True while the widget paints itself into the layer */
+    bool isRendering() const;
+
+    void draw( QPainter* pPainter ) const;
+
+private:
+    QPixmap mPixmap;
+    QString mKey;
+    bool mRendering;
+};
+
+#endif // STATICLAYER_H
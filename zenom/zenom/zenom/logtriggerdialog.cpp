@@ -0,0 +1,75 @@
+#include "logtriggerdialog.h"
+#include "ui_logtriggerdialog.h"
+
+LogTriggerDialog::LogTriggerDialog(QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::LogTriggerDialog)
+{
+    ui->setupUi(this);
+    on_mode_currentIndexChanged( ui->mode->currentIndex() );
+}
+
+LogTriggerDialog::~LogTriggerDialog()
+{
+    delete ui;
+}
+
+void LogTriggerDialog::setLogVariableList(const LogVariableList &pLogVariableList)
+{
+    mLogVariableList = pLogVariableList;
+
+    ui->source->clear();
+    for (unsigned int i = 0; i < pLogVariableList.size(); ++i)
+    {
+        ui->source->addItem( QString::fromStdString(pLogVariableList[i]->name()) );
+    }
+}
+
+void LogTriggerDialog::setTrigger(const LogTrigger &pTrigger)
+{
+    // combo box indices follow LogTrigger::Mode
+    ui->mode->setCurrentIndex( pTrigger.mode );
+    if ( pTrigger.isEnabled() )
+    {
+        ui->source->setCurrentIndex( pTrigger.source );
+        ui->element->setValue( pTrigger.element );
+        ui->level->setValue( pTrigger.level );
+        ui->high->setValue( pTrigger.high );
+        ui->preTrigger->setValue( pTrigger.preTrigger );
+        ui->postTrigger->setValue( pTrigger.postTrigger );
+    }
+}
+
+LogTrigger LogTriggerDialog::trigger()
+{
+    LogTrigger trigger = LogTrigger();
+    if ( ui->mode->currentIndex() != LogTrigger::TRIGGER_OFF && ui->source->currentIndex() >= 0 )
+    {
+        trigger.mode = ui->mode->currentIndex();
+        trigger.source = ui->source->currentIndex();
+        trigger.element = ui->element->value();
+        trigger.level = ui->level->value();
+        trigger.high = ui->high->value();
+        trigger.preTrigger = ui->preTrigger->value();
+        trigger.postTrigger = ui->postTrigger->value();
+    }
+    return trigger;
+}
+
+void LogTriggerDialog::on_mode_currentIndexChanged(int pIndex)
+{
+    const bool enabled = pIndex != LogTrigger::TRIGGER_OFF;
+    ui->source->setEnabled( enabled );
+    ui->element->setEnabled( enabled );
+    ui->level->setEnabled( enabled );
+    ui->high->setEnabled( pIndex == LogTrigger::TRIGGER_WINDOW );
+    ui->preTrigger->setEnabled( enabled );
+    ui->postTrigger->setEnabled( enabled );
+}
+
+void LogTriggerDialog::on_source_currentIndexChanged(int pIndex)
+{
+    // Matrices are watched element by element in row major order.
+    if ( pIndex >= 0 && pIndex < (int)mLogVariableList.size() )
+        ui->element->setMaximum( mLogVariableList[pIndex]->size() - 1 );
+}
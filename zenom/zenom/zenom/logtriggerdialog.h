@@ -0,0 +1,39 @@
+#ifndef LOGTRIGGERDIALOG_H
+#define LOGTRIGGERDIALOG_H
+
+#include <QDialog>
+#include <datarepository.h>
+#include <logtrigger.h>
+
+namespace Ui {
+class LogTriggerDialog;
+}
+
+/**
+ * Edits the trigger of a log variable: the condition, the variable it
+ * watches and the number of samples kept before and after the event.
+ */
+class LogTriggerDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit LogTriggerDialog(QWidget *parent = 0);
+    ~LogTriggerDialog();
+
+    void setLogVariableList( const LogVariableList& pLogVariableList );
+
+    void setTrigger( const LogTrigger& pTrigger );
+
+    LogTrigger trigger();
+
+private slots:
+    void on_mode_currentIndexChanged(int pIndex);
+    void on_source_currentIndexChanged(int pIndex);
+
+private:
+    Ui::LogTriggerDialog *ui;
+    LogVariableList mLogVariableList;
+};
+
+#endif // LOGTRIGGERDIALOG_H
@@ -1,5 +1,10 @@
 #include "logvariableswidget.h"
 #include "ui_logvariableswidget.h"
+#include "logtriggerdialog.h"
+
+#include <QMenu>
+#include <QSet>
+#include <QHash>
 
 
 LogVariablesWidget::LogVariablesWidget(QWidget *parent) :
@@ -16,6 +21,13 @@ LogVariablesWidget::LogVariablesWidget(QWidget *parent) :
 	mHeaderView = new CheckedHeader(Qt::Vertical, ui->logVariableTable);
 	connect( mHeaderView, SIGNAL(toggled(int,bool)), SLOT(setLogVariableChecked(int, bool)) );
     ui->logVariableTable->setVerticalHeader( mHeaderView );
+
+    mModel = new LogVariableTableModel(this);
+    ui->logVariableTable->setModel(mModel);
+
+    ui->logVariableTable->setContextMenuPolicy( Qt::CustomContextMenu );
+    connect( ui->logVariableTable, SIGNAL(customContextMenuRequested(const QPoint&)),
+             SLOT(showContextMenu(const QPoint&)) );
 }
 
 LogVariablesWidget::~LogVariablesWidget()
@@ -26,30 +38,24 @@ LogVariablesWidget::~LogVariablesWidget()
 
 void LogVariablesWidget::setLogVariableList(const LogVariableList &pLogVariableList)
 {
-    ui->logVariableTable->setRowCount( pLogVariableList.size() );
+    // Cells are created by the view when they are shown.
+    mModel->setLogVariableList( pLogVariableList );
 
-    LogVariable* logVariable;
     for ( size_t i = 0; i < pLogVariableList.size(); ++i )
     {
-        logVariable = pLogVariableList[i];
-
-        ui->logVariableTable->setItem( i, 0, new QTableWidgetItem(QString::fromStdString(logVariable->name())) );
-		ui->logVariableTable->setItem(i, 1, new QTableWidgetItem());
-        ui->logVariableTable->setItem(i, 2, new QTableWidgetItem());
-        ui->logVariableTable->setItem(i, 3, new QTableWidgetItem());
 		setLogVariableChecked( i, false );
     }
 }
 
 void LogVariablesWidget::clear()
 {
-    ui->logVariableTable->setRowCount(0);
+    mModel->setLogVariableList( LogVariableList() );
 }
 
 void LogVariablesWidget::mainFrequencyChanged(double pFrequency)
 {
 	// change frequency of unchecked log variables
-	for ( int i = 0; i < ui->logVariableTable->rowCount(); ++i )
+	for ( int i = 0; i < mModel->rowCount(); ++i )
 	{
 		if ( !mHeaderView->isChecked(i) )
 		{
@@ -61,7 +67,7 @@ void LogVariablesWidget::mainFrequencyChanged(double pFrequency)
 void LogVariablesWidget::mainDurationChanged( double pDuration )
 {
 	// change duration of unchecked log variables
-	for ( int i = 0; i < ui->logVariableTable->rowCount(); ++i )
+	for ( int i = 0; i < mModel->rowCount(); ++i )
 	{
 		if ( !mHeaderView->isChecked(i) )
 		{
@@ -76,14 +82,27 @@ void LogVariablesWidget::saveSettings(QSettings &pSettings)
     pSettings.setValue("geometry", saveGeometry());
     pSettings.setValue("visible", isVisible());
 
-    for ( int i = 0; i < ui->logVariableTable->rowCount(); ++i )
+	const LogVariableList& logVariables = DataRepository::instance()->logVariables();
+    for ( int i = 0; i < mModel->rowCount(); ++i )
     {
 		if ( mHeaderView->isChecked(i) )
 		{
-			pSettings.beginGroup(ui->logVariableTable->item(i, 0)->text());
-			pSettings.setValue("frequency", ui->logVariableTable->item(i, 1)->text());
-			pSettings.setValue("startTime", ui->logVariableTable->item(i, 2)->text());
-			pSettings.setValue("duration", ui->logVariableTable->item(i, 3)->text());
+			pSettings.beginGroup(QString::fromStdString(logVariables[i]->name()));
+			pSettings.setValue("frequency", QString::number(logVariables[i]->frequency()));
+			pSettings.setValue("startTime", QString::number(logVariables[i]->startTime()));
+			pSettings.setValue("duration", QString::number(logVariables[i]->duration()));
+
+			const LogTrigger& trigger = logVariables[i]->trigger();
+			if ( trigger.isEnabled() )
+			{
+				pSettings.setValue("triggerMode", trigger.mode);
+				pSettings.setValue("triggerSource", QString::fromStdString(logVariables[trigger.source]->name()));
+				pSettings.setValue("triggerElement", trigger.element);
+				pSettings.setValue("triggerLevel", trigger.level);
+				pSettings.setValue("triggerHigh", trigger.high);
+				pSettings.setValue("preTrigger", trigger.preTrigger);
+				pSettings.setValue("postTrigger", trigger.postTrigger);
+			}
 			pSettings.endGroup();
 		}
     }
@@ -96,15 +115,40 @@ void LogVariablesWidget::loadSettings(QSettings &pSettings)
     restoreGeometry( pSettings.value("geometry").toByteArray() );
     setVisible( pSettings.value("visible").toBool() );
 
-    for ( int i = 0; i < ui->logVariableTable->rowCount(); ++i )
+	// Groups and variable names are looked up once, not per variable.
+	const QSet<QString> groups = pSettings.childGroups().toSet();
+	const LogVariableList& logVariables = DataRepository::instance()->logVariables();
+	QHash<QString, int> indexes;
+	for ( size_t j = 0; j < logVariables.size(); ++j )
+	{
+		indexes.insert( QString::fromStdString(logVariables[j]->name()), j );
+	}
+
+    for ( int i = 0; i < mModel->rowCount(); ++i )
     {
-        if ( pSettings.childGroups().contains(ui->logVariableTable->item(i, 0)->text()) )
+        const QString name = QString::fromStdString( logVariables[i]->name() );
+        if ( groups.contains(name) )
         {
-            pSettings.beginGroup(ui->logVariableTable->item(i, 0)->text());
+            pSettings.beginGroup(name);
 			setLogVariableChecked( i, true );
 			setFrequency(i, pSettings.value("frequency", DataRepository::instance()->frequency()).toDouble());
 			setStartTime(i, pSettings.value("startTime", 0).toDouble());
 			setDuration(i, pSettings.value("duration", DataRepository::instance()->duration()).toDouble());
+
+			// Trigger source is saved by name, the variable order may change.
+			LogTrigger trigger = LogTrigger();
+			QHash<QString, int>::const_iterator source = indexes.constFind( pSettings.value("triggerSource").toString() );
+			if ( source != indexes.constEnd() )
+			{
+				trigger.mode = pSettings.value("triggerMode", LogTrigger::TRIGGER_OFF).toUInt();
+				trigger.source = source.value();
+				trigger.element = pSettings.value("triggerElement", 0).toUInt();
+				trigger.level = pSettings.value("triggerLevel", 0).toDouble();
+				trigger.high = pSettings.value("triggerHigh", 0).toDouble();
+				trigger.preTrigger = pSettings.value("preTrigger", 0).toUInt();
+				trigger.postTrigger = pSettings.value("postTrigger", 1).toUInt();
+			}
+			setTrigger( i, trigger );
             pSettings.endGroup();
         }
     }
@@ -112,97 +156,83 @@ void LogVariablesWidget::loadSettings(QSettings &pSettings)
     pSettings.endGroup();
 }
 
-void LogVariablesWidget::on_logVariableTable_itemChanged(QTableWidgetItem *item)
-{
-	if ( item->column() == 1 )      // Frequency
-	{
-		setFrequency(item->row(), item->text().toDouble());
-	}
-	else if ( item->column() == 2 ) // Start Time
-	{
-		setStartTime(item->row(), item->text().toDouble());
-	}
-	else if ( item->column() == 3 ) // Duration
-	{
-        setDuration(item->row(), item->text().toDouble());
-    }
-}
-
 void LogVariablesWidget::setFrequency( int pIndex, double pFrequency )
 {
 	LogVariable* logVariable = DataRepository::instance()->logVariables()[pIndex];
-	QTableWidgetItem* frequency = ui->logVariableTable->item(pIndex, 1);
-    if ( pFrequency > 0 ){
+    if ( pFrequency > 0 )
+    {
         logVariable->setFrequency( pFrequency );
-		frequency->setText( QString::number(pFrequency) );
-	}
-	else
-	{
-		frequency->setText( QString::number(logVariable->frequency()) );
+        mModel->updateRow( pIndex );
 	}
 }
 
 void LogVariablesWidget::setStartTime( int pIndex, double pStartTime )
 {
 	LogVariable* logVariable = DataRepository::instance()->logVariables()[pIndex];
-	QTableWidgetItem* startTime = ui->logVariableTable->item(pIndex, 2);
 	if ( pStartTime >= 0 )
 	{
 		logVariable->setStartTime( pStartTime );
-		startTime->setText( QString::number(pStartTime) );
-	}
-	else
-	{
-		startTime->setText( QString::number(logVariable->startTime()) );
+		mModel->updateRow( pIndex );
 	}
 }
 
 void LogVariablesWidget::setDuration( int pIndex, double pDuration )
 {
 	LogVariable* logVariable = DataRepository::instance()->logVariables()[pIndex];
-	QTableWidgetItem* duration = ui->logVariableTable->item(pIndex, 3);
 	if ( pDuration > 0 )
 	{
 		logVariable->setDuration( pDuration );
-		duration->setText( QString::number(pDuration) );
+		mModel->updateRow( pIndex );
 	}
-	else
+}
+
+void LogVariablesWidget::setTrigger( int pIndex, const LogTrigger& pTrigger )
+{
+	LogVariable* logVariable = DataRepository::instance()->logVariables()[pIndex];
+	logVariable->setTrigger( pTrigger );
+	mModel->updateRow( pIndex );
+}
+
+void LogVariablesWidget::editTrigger( int pIndex )
+{
+	const LogVariableList& logVariables = DataRepository::instance()->logVariables();
+
+	LogTriggerDialog dialog( this );
+	dialog.setLogVariableList( logVariables );
+	dialog.setTrigger( logVariables[pIndex]->trigger() );
+	if ( dialog.exec() == QDialog::Accepted )
 	{
-		duration->setText( QString::number(logVariable->duration()) );
+		setTrigger( pIndex, dialog.trigger() );
 	}
 }
 
-void LogVariablesWidget::setLogVariableChecked( int pIndex, bool pChecked )
+void LogVariablesWidget::showContextMenu( const QPoint& pPos )
 {
-	mHeaderView->setChecked(pIndex, pChecked);	
-	if ( pChecked )
-	{
-		Qt::ItemFlags flags = Qt::ItemIsEditable|Qt::ItemIsSelectable
-			|Qt::ItemIsUserCheckable|Qt::ItemIsEnabled|Qt::ItemIsDragEnabled|Qt::ItemIsDropEnabled;
+	QModelIndex index = ui->logVariableTable->indexAt( pPos );
+	if ( !index.isValid() )
+		return;
 
-		ui->logVariableTable->item(pIndex, 0)->setFlags(Qt::ItemIsEnabled);
-		ui->logVariableTable->item(pIndex, 1)->setFlags(flags);		
-		ui->logVariableTable->item(pIndex, 2)->setFlags(flags);		
-		ui->logVariableTable->item(pIndex, 3)->setFlags(flags);		
-	}
-	else
+	// Only customized log variables keep their settings.
+	QMenu menu;
+	QAction* triggerAction = menu.addAction( tr("Trigger...") );
+	triggerAction->setEnabled( mHeaderView->isChecked(index.row()) );
+	if ( menu.exec( ui->logVariableTable->viewport()->mapToGlobal(pPos) ) == triggerAction )
 	{
-		ui->logVariableTable->item(pIndex, 0)->setFlags(Qt::NoItemFlags);
-		ui->logVariableTable->item(pIndex, 1)->setFlags(Qt::NoItemFlags);
-		ui->logVariableTable->item(pIndex, 2)->setFlags(Qt::NoItemFlags);
-		ui->logVariableTable->item(pIndex, 3)->setFlags(Qt::NoItemFlags);
+		editTrigger( index.row() );
+	}
+}
 
+void LogVariablesWidget::setLogVariableChecked( int pIndex, bool pChecked )
+{
+	mHeaderView->setChecked(pIndex, pChecked);	
+	mModel->setCustomized(pIndex, pChecked);
+	if ( !pChecked )
+	{
 		setFrequency(pIndex, DataRepository::instance()->frequency());
 		setStartTime(pIndex, 0);
 		setDuration(pIndex, DataRepository::instance()->duration());
+		setTrigger(pIndex, LogTrigger());
 	}
-
-	QFont font = ui->logVariableTable->item(pIndex, 0)->font();
-	font.setBold(pChecked);
-	ui->logVariableTable->item(pIndex, 0)->setFont(font);
-	ui->logVariableTable->item(pIndex, 1)->setFont(font);
-	ui->logVariableTable->item(pIndex, 2)->setFont(font);
-	ui->logVariableTable->item(pIndex, 3)->setFont(font);
 }
 
 QAction* LogVariablesWidget::toggleViewAction() const
@@ -2,11 +2,11 @@
 #define LOGVARIABLESWIDGET_H
 
 #include <QWidget>
-#include <QTableWidgetItem>
 #include <QSettings>
 
 #include "datarepository.h"
 #include "widget/checkedheader.h"
+#include "widget/logvariabletablemodel.h"
 
 namespace Ui {
 class LogVariablesWidget;
@@ -38,18 +38,21 @@ protected:
     bool event(QEvent *pEvent);
 
 private slots:
-    void on_logVariableTable_itemChanged(QTableWidgetItem * item);
 	void setLogVariableChecked(int pIndex, bool pChecked);
     void toggleView(bool pChecked);
+    void showContextMenu(const QPoint& pPos);
     
 private:
     Ui::LogVariablesWidget *ui;
 	CheckedHeader* mHeaderView;
     QAction* mToggleViewAction;
+    LogVariableTableModel* mModel;
 
 	void setFrequency( int pIndex, double pFrequency );
 	void setStartTime( int pIndex, double pStartTime );
     void setDuration( int pIndex, double pDuration );
+    void setTrigger( int pIndex, const LogTrigger& pTrigger );
+    void editTrigger( int pIndex );
 };
 
 #endif // LOGVARIABLESWIDGET_H
@@ -22,7 +22,9 @@ void MessageListenerTask::run()
     while( mZenom->simulationState() != TERMINATED &&
            mZenom->simulationState() != CRASHED)
     {
-        if( DataRepository::instance()->readState( &stateRequest ) > 0 )
+        // Wakes on a message; the timeout only bounds how long a state
+        // change without a message (crash, kill) takes to be noticed.
+        if( DataRepository::instance()->readState( &stateRequest, 100 ) > 0 )
         {
             std::cerr << "MessageListenerTask state read" << std::endl;
             switch (stateRequest)
@@ -41,13 +43,16 @@ void MessageListenerTask::run()
                     std::cerr << "read state R_STOP" << std::endl;
                     break;
 
+                case R_TERMINATE:
+                    // The control base is exiting, nothing more will come.
+                    return;
+
                 default:
                     std::cout << "Message Listener Unhandled message" <<
                                  std::endl;
                     break;
             }
         }
-        usleep(100*1000); //100ms 10hz
     }
 }
 
@@ -34,3 +34,8 @@ void LegendItem::setSize(const int pSize)
 {
     ui->lineSizeCombo->setSize(pSize);
 }
+
+void LegendItem::setStatistics( const RunningStatistics& pStatistics )
+{
+    ui->curveName->setToolTip( pStatistics.toString() );
+}
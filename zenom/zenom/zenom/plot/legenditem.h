@@ -2,6 +2,7 @@
 #define LEGENDITEM_H
 
 #include <QWidget>
+#include "widget/runningstatistics.h"
 
 namespace Ui {
 class LegendItem;
@@ -21,6 +22,8 @@ public:
 
     void setSize( const int );
 
+    void setStatistics( const RunningStatistics& pStatistics );
+
 signals:
     void colorChanged( const QColor& );
     void removeRequest();
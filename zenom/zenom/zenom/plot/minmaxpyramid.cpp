@@ -0,0 +1,144 @@
+#include "minmaxpyramid.h"
+#include <algorithm>
+
+// 8^10 samples per top bucket is more than any heap holds.
+static const int MAX_LEVELS = 10;
+
+MinMaxPyramid::MinMaxPyramid()
+    : mNextSequence(0)
+{
+
+}
+
+void MinMaxPyramid::clear()
+{
+    mLevels.clear();
+    mNextSequence = 0;
+}
+
+void MinMaxPyramid::merge( Bucket& pBucket, const Bucket& pOther, bool pEmpty )
+{
+    if ( pEmpty )
+    {
+        pBucket = pOther;
+        return;
+    }
+
+    if ( pOther.min < pBucket.min )
+    {
+        pBucket.min = pOther.min;
+        pBucket.minTime = pOther.minTime;
+    }
+
+    if ( pOther.max > pBucket.max )
+    {
+        pBucket.max = pOther.max;
+        pBucket.maxTime = pOther.maxTime;
+    }
+}
+
+void MinMaxPyramid::append( uint64_t pSequence, double pTime, double pValue )
+{
+    if ( !mLevels.empty() && pSequence != mNextSequence )
+        clear();
+    mNextSequence = pSequence + 1;
+
+    Bucket sample = { pTime, pValue, pTime, pValue };
+    push( 0, pSequence, sample );
+}
+
+void MinMaxPyramid::push( int pLevel, uint64_t pIndex, const Bucket& pBucket )
+{
+    if ( pLevel == (int)mLevels.size() )
+    {
+        Level level;
+        level.base = pIndex / FANOUT;
+        level.first = 0;
+        level.partialCount = 0;
+        mLevels.push_back( level );
+    }
+
+    Level& level = mLevels[pLevel];
+    merge( level.partial, pBucket, level.partialCount == 0 );
+    ++level.partialCount;
+
+    // pIndex is the last child of its bucket, the bucket is complete.
+    if ( (pIndex + 1) % FANOUT == 0 )
+    {
+        const Bucket complete = level.partial;
+        level.buckets.push_back( complete );
+        level.partialCount = 0;
+
+        if ( pLevel + 1 < MAX_LEVELS )
+            push( pLevel + 1, pIndex / FANOUT, complete );
+    }
+}
+
+void MinMaxPyramid::dropBefore( uint64_t pSequence )
+{
+    for ( size_t i = 0; i < mLevels.size(); ++i )
+    {
+        Level& level = mLevels[i];
+        const uint64_t firstLive = pSequence / bucketSpan( i );
+        if ( firstLive > level.base + level.first )
+        {
+            level.first = std::min<uint64_t>( firstLive - level.base,
+                                              level.buckets.size() );
+        }
+
+        // Compact once the dropped part dominates.
+        if ( level.first > 1024 && level.first * 2 > level.buckets.size() )
+        {
+            level.buckets.erase( level.buckets.begin(),
+                                 level.buckets.begin() + level.first );
+            level.base += level.first;
+            level.first = 0;
+        }
+    }
+}
+
+int MinMaxPyramid::levelCount() const
+{
+    return mLevels.size();
+}
+
+uint64_t MinMaxPyramid::bucketSpan( int pLevel )
+{
+    uint64_t span = 1;
+    for ( int i = 0; i <= pLevel; ++i )
+        span *= FANOUT;
+    return span;
+}
+
+MinMaxPyramid::Bucket MinMaxPyramid::tail( int pLevel, bool* pEmpty ) const
+{
+    Bucket bucket = Bucket();
+    *pEmpty = true;
+    for ( int i = pLevel; i >= 0; --i )
+    {
+        if ( mLevels[i].partialCount )
+        {
+            merge( bucket, mLevels[i].partial, *pEmpty );
+            *pEmpty = false;
+        }
+    }
+    return bucket;
+}
+
+size_t MinMaxPyramid::bucketCount( int pLevel ) const
+{
+    const Level& level = mLevels[pLevel];
+    bool empty;
+    tail( pLevel, &empty );
+    return level.buckets.size() - level.first + (empty ? 0 : 1);
+}
+
+MinMaxPyramid::Bucket MinMaxPyramid::bucket( int pLevel, size_t pIndex ) const
+{
+    const Level& level = mLevels[pLevel];
+    if ( level.first + pIndex < level.buckets.size() )
+        return level.buckets[level.first + pIndex];
+
+    bool empty;
+    return tail( pLevel, &empty );
+}
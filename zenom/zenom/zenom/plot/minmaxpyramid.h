@@ -0,0 +1,76 @@
+#ifndef MINMAXPYRAMID_H
+#define MINMAXPYRAMID_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Min/max decimation pyramid of a curve. Level k groups FANOUT^(k+1)
+ * consecutive samples into one bucket that keeps the lowest and the
+ * highest sample, so drawing both points of every bucket traces the same
+ * envelope as drawing every sample.
+ *
+ * Samples are appended as the log heap grows and buckets are addressed by
+ * sequence number; a sliding ring buffer window only drops the oldest
+ * buckets. Nothing is ever rebuilt.
+ */
+class MinMaxPyramid
+{
+public:
+    struct Bucket
+    {
+        double minTime;
+        double min;
+        double maxTime;
+        double max;
+    };
+
+    static const unsigned int FANOUT = 8;
+
+    MinMaxPyramid();
+
+    void clear();
+
+    /**
+     * Appends the sample with sequence number pSequence. Sequence numbers
+     * must be consecutive; after a gap the pyramid starts over.
+     */
+    void append( uint64_t pSequence, double pTime, double pValue );
+
+    /** Drops the buckets that end before pSequence. */
+    void dropBefore( uint64_t pSequence );
+
+    int levelCount() const;
+
+    /** Samples per bucket of the level */
+    static uint64_t bucketSpan( int pLevel );
+
+    /** Buckets of the level, the last one may be partial */
+    size_t bucketCount( int pLevel ) const;
+
+    Bucket bucket( int pLevel, size_t pIndex ) const;
+
+private:
+    struct Level
+    {
+        std::vector<Bucket> buckets;    // complete buckets
+        uint64_t base;                  // bucket number of buckets[0]
+        size_t first;                   // first bucket still in the heap
+        Bucket partial;
+        unsigned int partialCount;
+    };
+
+    static void merge( Bucket& pBucket, const Bucket& pOther, bool pEmpty );
+
+    /** Adds a complete bucket of level pLevel - 1 (or a sample) to pLevel */
+    void push( int pLevel, uint64_t pIndex, const Bucket& pBucket );
+
+    /** Partial bucket of pLevel including the samples still below it */
+    Bucket tail( int pLevel, bool* pEmpty ) const;
+
+    std::vector<Level> mLevels;
+    uint64_t mNextSequence;
+};
+
+#endif // MINMAXPYRAMID_H
@@ -7,13 +7,21 @@
 #include <qwt_plot_grid.h>
 #include <qwt_plot_marker.h>
 #include <qwt_plot_renderer.h>
+#include <qwt_plot_canvas.h>
 #include "plotmagnifier.h"
-#include "utility/matlabstream.h"
+#include "legenditem.h"
+#include "utility/matlabexporter.h"
+#include "utility/binaryexporter.h"
 #include <datarepository.h>
 
 
 Plot::Plot(QWidget* pParent): QwtPlot(pParent)
 {
+    mDirty = false;
+    mDrawingCanvas = false;
+    mRenderer = new PlotRenderer( this );
+    connect( mRenderer, SIGNAL(frameReady()), this, SLOT(frameReady()) );
+
     setAxisTitle( QwtPlot::xBottom, "Time [s]" );
     setCanvasBackground( Qt::white );
     insertLegend( new QwtLegend, QwtPlot::RightLegend );
@@ -79,6 +87,7 @@ void Plot::loadSettings( QSettings& pSettings )
             newCurve->attach( this );
             mCurveVec.push_back(newCurve);
             mColorGenerator.increaseIndex();
+            mDirty = true;
         }
     }
 }
@@ -92,18 +101,29 @@ void Plot::attactLogVariableItems( const QList<LogVariableItem>& pLogVariableIte
         newCurve->setPen( QPen( mColorGenerator.generateColor() ));
         newCurve->attach( this );
         mCurveVec.push_back(newCurve);
+        mDirty = true;
     }
 }
 
 void Plot::tick()
 {
+    bool changed = mDirty;
     double maxTime = -1;
     for (int i = 0 ; i < mCurveVec.size(); ++i)
     {
-        mCurveVec[i]->tick();
+        if ( mCurveVec[i]->tick() )
+        {
+            changed = true;
+            QWidget* legendItem = legend() ? legend()->find( mCurveVec[i] ) : NULL;
+            if ( legendItem )
+                ((LegendItem*)legendItem)->setStatistics( mCurveVec[i]->statistics() );
+        }
         maxTime = qMax( maxTime, mCurveVec[i]->data()->boundingRect().right() );
     }
 
+    if ( !changed )
+        return;
+
     // Increment interval
     if ( maxTime > d_interval.maxValue() )
     {
@@ -117,9 +137,72 @@ void Plot::tick()
         setAutoscaleAndInterval( autoscale(), 0, timeInterval() );
     }
 
+    mDirty = false;
     replot();
 }
 
+void Plot::replot()
+{
+    QwtPlot::replot();
+
+    PlotRenderer::Frame frame;
+    frame.size = canvas()->size();
+    frame.xMap = canvasMap( QwtPlot::xBottom );
+    frame.yMap = canvasMap( QwtPlot::yLeft );
+    if ( frame.size.isEmpty() )
+        return;
+
+    for (int i = 0 ; i < mCurveVec.size(); ++i)
+    {
+        if ( !mCurveVec[i]->isVisible() )
+            continue;
+
+        PlotRenderer::Curve curve;
+        if ( mCurveVec[i]->visibleSamples(frame.xMap, curve.samples) )
+        {
+            LogVariable* logVariable = mCurveVec[i]->logVariableItem().logVariable();
+            const VariableType type = logVariable ? logVariable->type() : VARIABLE_DOUBLE;
+            curve.pen = mCurveVec[i]->pen();
+            curve.antialiased = mCurveVec[i]->testRenderHint( QwtPlotItem::RenderAntialiased );
+            curve.steps = type != VARIABLE_DOUBLE && type != VARIABLE_FLOAT;
+            frame.curves.push_back( curve );
+        }
+    }
+
+    mRenderer->render( frame );
+}
+
+bool Plot::isDrawingCanvas() const
+{
+    return mDrawingCanvas;
+}
+
+void Plot::drawCanvas( QPainter* pPainter )
+{
+    mDrawingCanvas = true;
+    QwtPlot::drawCanvas( pPainter );
+    mDrawingCanvas = false;
+}
+
+void Plot::drawItems( QPainter* pPainter, const QRectF& pCanvasRect,
+                      const QwtScaleMap pMaps[axisCnt] ) const
+{
+    QwtPlot::drawItems( pPainter, pCanvasRect, pMaps );
+
+    // QwtPlotRenderer draws the items without the canvas, the heap
+    // curves have drawn themselves there.
+    if ( mDrawingCanvas )
+        mRenderer->draw( pPainter, pMaps[QwtPlot::xBottom], pMaps[QwtPlot::yLeft] );
+}
+
+void Plot::frameReady()
+{
+    // Only the canvas is repainted, the axes did not change.
+    canvas()->invalidatePaintCache();
+    canvas()->update();
+    emit frameRendered( mRenderer->frameTime() );
+}
+
 void Plot::legendColorChanged( const QColor& pColor )
 {
     if ( legend() && sender()->isWidgetType() )
@@ -195,6 +278,7 @@ void Plot::zoommed_or_panned()
 void Plot::setAutoscaleAndInterval( bool pOn, double pMin, double pMax )
 {
     mAutoscale = pOn;
+    mDirty = true;
 
     d_interval.setMinValue( pMin );
     d_interval.setMaxValue( pMax );
@@ -230,22 +314,17 @@ void Plot::importCurvesFromText( const QString &pFileName )
 
 void Plot::exportCurvesAsBinary( const QString& pFileName )
 {
-    QFile file( pFileName );
-    if (!file.open(QIODevice::WriteOnly))
-        return;
-
-    QDataStream out(&file);
+    BinaryExporter exporter( pFileName );
 
-    // Writes the points to stream out
+    // Every heap sample, not the decimated view on screen.
     for( int i = 0; i < mCurveVec.size(); ++i )
     {
-        QVector<QPointF> data;
-        for(size_t j = 0; j < mCurveVec[i]->data()->size(); ++j)
-        {
-            data.push_back( mCurveVec[i]->data()->sample(j) );
-        }
-        out << mCurveVec[i]->title().text() << data;
+        LogVariableItem logVariableItem = mCurveVec[i]->logVariableItem();
+        exporter.addLogVariableItem( mCurveVec[i]->title().text(), logVariableItem.logVariable(),
+                                     logVariableItem.row(), logVariableItem.column() );
     }
+
+    exporter.exec( this );
 }
 
 void Plot::exportCurvesAsImage( const QString& pFileName )
@@ -261,17 +340,14 @@ void Plot::exportCurvesAsImage( const QString& pFileName )
 
 void Plot::exportCurvesAsMatlab(const QString &pFileName)
 {
-    QFile file( pFileName );
-    if (!file.open(QIODevice::WriteOnly))
-        return;
+    MatlabExporter exporter( pFileName );
 
-    MatlabStream out(&file);
-
-    // Writes the points to stream out
+    // Writes the points to the file
     for( int i = 0; i < mCurveVec.size(); ++i )
     {
         LogVariableItem logVariableItem = mCurveVec[i]->logVariableItem();
-        out.writeLogVariableItem( logVariableItem.logVariable(), logVariableItem.row(), logVariableItem.column() );
-        out.writeLogVariableTime( logVariableItem.logVariable() );
+        exporter.addLogVariableItem( logVariableItem.logVariable(), logVariableItem.row(), logVariableItem.column() );
     }
+
+    exporter.exec( this );
 }
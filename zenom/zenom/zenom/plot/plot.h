@@ -9,6 +9,7 @@
 #include "widget/logvariableitem.h"
 #include "plotcurve.h"
 #include "curvecolorgenerator.h"
+#include "plotrenderer.h"
 
 
 class Plot : public QwtPlot
@@ -25,6 +26,7 @@ public:
 
     void attactLogVariableItems( const QList<LogVariableItem>& pLogVariableItems );
 
+    /** Updates the curves, and replots only if one of them changed. */
     void tick();
 
     double timeInterval();
@@ -42,15 +44,35 @@ public:
     void exportCurvesAsImage( const QString& pFileName );
 
     /**
-     * Plotta bulunan egrileri Matlab (.m) dosya formatina uygun olarak
+     * Plotta bulunan egrileri Matlab (.mat) dosya formatina uygun olarak
      * kayit eder.
      * @param pFileName kayit edilecek dosya ismi
      */
     void exportCurvesAsMatlab( const QString& pFileName );
 
+    /**
+     * True while the canvas is painted. Heap curves are drawn from the
+     * rendered image there, and by Qwt on any other painter (image
+     * export, print).
+     */
+    bool isDrawingCanvas() const;
+
+public slots:
+    /** Redraws axes and items, and renders the curves on a worker thread */
+    virtual void replot();
+
 signals:
     void autoscaleOff();
 
+    /** A frame of curves is drawn, pTime is its render time in ms */
+    void frameRendered( double pTime );
+
+protected:
+    virtual void drawCanvas( QPainter* pPainter );
+
+    virtual void drawItems( QPainter* pPainter, const QRectF& pCanvasRect,
+                            const QwtScaleMap pMaps[axisCnt] ) const;
+
 protected slots:
     void legendColorChanged( const QColor& pColor );
 
@@ -60,6 +82,9 @@ protected slots:
 
     void zoommed_or_panned();
 
+private slots:
+    void frameReady();
+
 private:
     void setAutoscaleAndInterval( bool pOn, double pMin, double pMax );
 
@@ -67,6 +92,9 @@ private:
     CurveColorGenerator mColorGenerator;
     QwtInterval d_interval;
     bool mAutoscale;
+    bool mDirty;    // curves or scales changed since the last tick
+    PlotRenderer* mRenderer;
+    bool mDrawingCanvas;
 };
 
 #endif // PLOT_H
@@ -4,28 +4,263 @@
 #include "plot.h"
 
 #include <qwt_series_data.h>
+#include <qwt_scale_map.h>
+#include <datarepository.h>
+#include <algorithm>
+
+namespace
+{
+
+// First index in [0, pCount) whose time is not less than pTime (pUpper
+// false) or greater than pTime (pUpper true). pTimeAt(i) must not decrease.
+template <typename TimeAt>
+size_t searchTime( size_t pCount, double pTime, bool pUpper, TimeAt pTimeAt )
+{
+    size_t first = 0;
+    while ( pCount > 0 )
+    {
+        const size_t half = pCount / 2;
+        const double time = pTimeAt( first + half );
+        if ( pUpper ? time <= pTime : time < pTime )
+        {
+            first += half + 1;
+            pCount -= half + 1;
+        }
+        else
+        {
+            pCount = half;
+        }
+    }
+    return first;
+}
+
+}
 
 /*
  *  CurveData
  */
 CurveData::CurveData()
-    : mLastHeapSize(0)
+    : mHeapGeneration(0)
+    , mLastWriteSequence(0)
+    , mFirstSequence(0)
+    , mSize(0)
+    , mViewLevel(-1)
+    , mViewBegin(0)
+    , mViewSize(0)
+{
+
+}
+
+QPointF CurveData::sample( size_t i ) const
+{
+    if ( mViewLevel < 0 )
+        return rawSample( mViewBegin + i );
+
+    // Both points of a bucket, in time order.
+    MinMaxPyramid::Bucket bucket = mPyramid.bucket( mViewLevel, mViewBegin + i / 2 );
+    const bool minFirst = bucket.minTime <= bucket.maxTime;
+    if ( (i % 2 == 0) == minFirst )
+        return QPointF( bucket.minTime, bucket.min );
+    return QPointF( bucket.maxTime, bucket.max );
+}
+
+size_t CurveData::size() const
+{
+    if ( !mLogVariableItem.isValid() )
+        return 0;
+
+    return mViewLevel < 0 ? mViewSize : 2 * mViewSize;
+}
+
+size_t CurveData::sampleCount() const
 {
+    return mLogVariableItem.isValid() ? mSize : 0;
+}
+
+QPointF CurveData::rawSample( size_t pIndex ) const
+{
+    return mLogVariableItem.heapElementBySequence( mFirstSequence + pIndex );
+}
 
+void CurveData::copyRawSamples( size_t pFirst, size_t pCount, QPointF* pDest ) const
+{
+    mLogVariableItem.copyHeapSamples( mFirstSequence + pFirst, pCount, pDest );
 }
 
-void CurveData::updateBoundingRect()
+void CurveData::copyView( QVector<QPointF>& pSamples ) const
 {
-    if ( mLogVariableItem.isValid() && mLastHeapSize != mLogVariableItem.size() )
+    const size_t count = size();
+    pSamples.resize( count );
+    if ( mViewLevel < 0 )
     {
-        mLastHeapSize = mLogVariableItem.size();
-        d_boundingRect = qwtBoundingRect( *this );   // TODO
+        copyRawSamples( mViewBegin, count, pSamples.data() );
+        return;
+    }
+
+    for ( size_t i = 0; i < count; ++i )
+    {
+        pSamples[i] = sample( i );
     }
 }
 
+bool CurveData::updateBoundingRect()
+{
+    if ( !mLogVariableItem.isValid() )
+        return false;
+
+    // Every start creates a new heap. Its sequence numbers may already
+    // be past the last one seen from the old heap, so they cannot tell.
+    const uint64_t heapGeneration = DataRepository::instance()->logHeapGeneration();
+    const bool newHeap = heapGeneration != mHeapGeneration;
+    if ( newHeap )
+    {
+        reset();
+        mHeapGeneration = heapGeneration;
+    }
+
+    LogVariable* logVariable = mLogVariableItem.logVariable();
+    uint64_t writeSequence = logVariable->writeSequence();
+    if ( mLastWriteSequence == writeSequence && !newHeap )
+        return false;
+
+    mSize = std::min( writeSequence, logVariable->heapCapacity() );
+    mFirstSequence = writeSequence - mSize;
+
+    // Only the samples written since the last tick are added, copied
+    // in blocks that stay in the cache. The writer does not wait, so a
+    // ring heap may wrap during a copy; the samples it overwrote are
+    // dropped before they reach the pyramid or the statistics.
+    const uint64_t BLOCK_SIZE = 4096;
+    uint64_t sequence = std::max( mLastWriteSequence, mFirstSequence );
+    while ( sequence < writeSequence )
+    {
+        const uint64_t count = std::min( writeSequence - sequence, BLOCK_SIZE );
+        mLogVariableItem.copyHeapSamples( sequence, count, mNewSamples );
+        const uint64_t intact = std::min( logVariable->firstIntactSequence( sequence ),
+                                          sequence + count );
+        for ( uint64_t i = intact - sequence; i < count; ++i )
+        {
+            const QPointF& point = mNewSamples[i];
+            mPyramid.append( sequence + i, point.x(), point.y() );
+            mStatistics.add( point.y() );
+        }
+        sequence += count;
+    }
+
+    // The window starts at the oldest sample still intact; the next tick
+    // continues from writeSequence.
+    mFirstSequence = std::min( logVariable->firstIntactSequence( mFirstSequence ),
+                               writeSequence );
+    mSize = writeSequence - mFirstSequence;
+    mPyramid.dropBefore( mFirstSequence );
+    mLastWriteSequence = writeSequence;
+
+    // The coarsest level has only a few buckets, and unlike the run
+    // statistics it follows a sliding ring buffer window.
+    const int top = mPyramid.levelCount() - 1;
+    const size_t count = top < 0 ? 0 : mPyramid.bucketCount( top );
+    for ( size_t i = 0; i < count; ++i )
+    {
+        MinMaxPyramid::Bucket bucket = mPyramid.bucket( top, i );
+        if ( i == 0 )
+        {
+            d_boundingRect.setCoords( bucket.minTime, bucket.min,
+                                      bucket.minTime, bucket.max );
+        }
+        d_boundingRect.setLeft( qMin(d_boundingRect.left(), qMin(bucket.minTime, bucket.maxTime)) );
+        d_boundingRect.setRight( qMax(d_boundingRect.right(), qMax(bucket.minTime, bucket.maxTime)) );
+        d_boundingRect.setTop( qMin(d_boundingRect.top(), bucket.min) );
+        d_boundingRect.setBottom( qMax(d_boundingRect.bottom(), bucket.max) );
+    }
+    return true;
+}
+
+void CurveData::selectView( double pMinTime, double pMaxTime, double pPixels )
+{
+    mViewLevel = -1;
+    mViewBegin = 0;
+    mViewSize = mSize;
+    if ( !mLogVariableItem.isValid() )
+        return;
+
+    const double minTime = qMin( pMinTime, pMaxTime );
+    const double maxTime = qMax( pMinTime, pMaxTime );
+
+    // Visible raw samples and one sample of margin on each side, so the
+    // lines to the points outside the canvas are still drawn.
+    LogVariable* logVariable = mLogVariableItem.logVariable();
+    const uint64_t firstSequence = mFirstSequence;
+    auto rawTime = [logVariable, firstSequence]( size_t pIndex )
+    {
+        return logVariable->heapTimeBySequence( firstSequence + pIndex );
+    };
+
+    size_t begin = searchTime( mSize, minTime, false, rawTime );
+    size_t end = searchTime( mSize, maxTime, true, rawTime );
+    begin = begin > 0 ? begin - 1 : 0;
+    end = std::min( end + 1, mSize );
+    mViewBegin = begin;
+    mViewSize = end > begin ? end - begin : 0;
+
+    // At most 4 points per pixel; a bucket is drawn as 2 points. The
+    // finest level that fits keeps at least one bucket per pixel.
+    if ( pPixels < 1 || mViewSize <= 4 * pPixels )
+        return;
+
+    for ( int level = 0; level < mPyramid.levelCount(); ++level )
+    {
+        mViewLevel = level;
+        if ( mViewSize / MinMaxPyramid::bucketSpan(level) <= 2 * pPixels )
+            break;
+    }
+
+    // Buckets hold consecutive samples, so both their first and last
+    // drawn times are monotonic. The margin bucket on the left ends
+    // before the interval, the one on the right starts after it.
+    const MinMaxPyramid& pyramid = mPyramid;
+    const int level = mViewLevel;
+    auto bucketLast = [&pyramid, level]( size_t pIndex )
+    {
+        MinMaxPyramid::Bucket bucket = pyramid.bucket( level, pIndex );
+        return qMax( bucket.minTime, bucket.maxTime );
+    };
+    auto bucketFirst = [&pyramid, level]( size_t pIndex )
+    {
+        MinMaxPyramid::Bucket bucket = pyramid.bucket( level, pIndex );
+        return qMin( bucket.minTime, bucket.maxTime );
+    };
+
+    const size_t count = mPyramid.bucketCount( level );
+    begin = searchTime( count, minTime, false, bucketLast );
+    end = searchTime( count, maxTime, true, bucketFirst );
+    begin = begin > 0 ? begin - 1 : 0;
+    end = std::min( end + 1, count );
+    mViewBegin = begin;
+    mViewSize = end > begin ? end - begin : 0;
+}
+
+const RunningStatistics& CurveData::statistics() const
+{
+    return mStatistics;
+}
+
 void CurveData::setLogVariableItem(const LogVariableItem& pItem )
 {
     mLogVariableItem = pItem;
+    reset();
+}
+
+void CurveData::reset()
+{
+    mPyramid.clear();
+    mStatistics.clear();
+    mLastWriteSequence = 0;
+    mFirstSequence = 0;
+    mSize = 0;
+    mViewLevel = -1;
+    mViewBegin = 0;
+    mViewSize = 0;
+    d_boundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
 }
 
 LogVariableItem CurveData::logVariableItem()
@@ -41,6 +276,7 @@ void CurveData::saveSettings(QSettings &pSettings)
 void CurveData::loadSettings(QSettings &pSettings)
 {
     mLogVariableItem.loadSettings(pSettings);
+    reset();
 }
 
 
@@ -65,6 +301,21 @@ LogVariableItem PlotCurve::logVariableItem()
     return mCurveData->logVariableItem();
 }
 
+const RunningStatistics& PlotCurve::statistics() const
+{
+    return mCurveData->statistics();
+}
+
+bool PlotCurve::visibleSamples( const QwtScaleMap& pXMap, QVector<QPointF>& pSamples ) const
+{
+    if ( data() != mCurveData )
+        return false;
+
+    mCurveData->selectView( pXMap.s1(), pXMap.s2(), qAbs(pXMap.p2() - pXMap.p1()) );
+    mCurveData->copyView( pSamples );
+    return true;
+}
+
 void PlotCurve::saveSettings(QSettings &pSettings)
 {
     pSettings.setValue("ColorR", pen().color().red());
@@ -88,9 +339,33 @@ void PlotCurve::loadSettings(QSettings &pSettings)
     setTitle( mCurveData->logVariableItem().name() );
 }
 
-void PlotCurve::tick()
+bool PlotCurve::tick()
+{
+    return mCurveData->updateBoundingRect();
+}
+
+void PlotCurve::drawSeries( QPainter* pPainter,
+                            const QwtScaleMap& pXMap, const QwtScaleMap& pYMap,
+                            const QRectF& pCanvasRect, int pFrom, int pTo ) const
 {
-    mCurveData->updateBoundingRect();
+    // Curves imported from a file replace the heap data with their samples.
+    if ( data() != mCurveData )
+    {
+        QwtPlotCurve::drawSeries( pPainter, pXMap, pYMap, pCanvasRect, pFrom, pTo );
+        return;
+    }
+
+    // On the canvas heap curves come from the image rendered off the GUI
+    // thread. Other painters (image export, print) have their own maps,
+    // so the view is selected for them and drawn by Qwt.
+    const Plot* ownerPlot = static_cast<const Plot*>( plot() );
+    if ( ownerPlot && ownerPlot->isDrawingCanvas() )
+        return;
+
+    mCurveData->selectView( pXMap.s1(), pXMap.s2(), qAbs(pXMap.p2() - pXMap.p1()) );
+    const int last = (int)mCurveData->size() - 1;
+    if ( last >= 0 )
+        QwtPlotCurve::drawSeries( pPainter, pXMap, pYMap, pCanvasRect, 0, last );
 }
 
 QWidget* PlotCurve::legendItem() const
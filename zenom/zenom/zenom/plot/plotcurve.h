@@ -3,18 +3,27 @@
 
 #include <qwt_plot_curve.h>
 #include "widget/logvariableitem.h"
+#include "minmaxpyramid.h"
+#include "widget/runningstatistics.h"
 
 /*
  *  CurveData
+ *
+ *  Exposes the heap of a log variable item to Qwt. Before each draw the
+ *  curve selects a view: the raw samples when they fit the canvas width,
+ *  otherwise the pyramid level whose buckets are about one pixel wide.
+ *  Only the slice of the view inside the visible time interval, plus one
+ *  point on each side, is exposed; it is found by binary search because
+ *  log time stamps are monotonic.
  */
 class CurveData : public QwtSeriesData<QPointF>
 {
 public:
     CurveData();
 
-    virtual QPointF sample( size_t i ) const { return mLogVariableItem.heapElement(i); }
+    virtual QPointF sample( size_t i ) const;
 
-    virtual size_t size() const { return mLogVariableItem.isValid() ? mLogVariableItem.size() : 0; }
+    virtual size_t size() const;
 
     virtual QRectF boundingRect() const { return d_boundingRect; }
 
@@ -22,15 +31,60 @@ public:
 
     LogVariableItem logVariableItem();
 
-    void updateBoundingRect();
+    /**
+     * Adds the samples written since the last call to the pyramid and the
+     * statistics, then updates the bounding rect. The cost depends on the
+     * new samples only.
+     * @return false if no sample was written since the last call
+     */
+    bool updateBoundingRect();
+
+    /** Statistics of the samples of the run so far */
+    const RunningStatistics& statistics() const;
+
+    /**
+     * Selects the samples drawn for the visible time interval
+     * [pMinTime, pMaxTime] on a canvas pPixels wide. The cost is
+     * logarithmic in the number of samples.
+     */
+    void selectView( double pMinTime, double pMaxTime, double pPixels );
+
+    /** Number of heap samples, independent of the view */
+    size_t sampleCount() const;
+
+    /** pIndex. heap sample, independent of the view */
+    QPointF rawSample( size_t pIndex ) const;
+
+    /** Copies pCount heap samples from pFirst in one pass */
+    void copyRawSamples( size_t pFirst, size_t pCount, QPointF* pDest ) const;
+
+    /** Copies the samples of the selected view */
+    void copyView( QVector<QPointF>& pSamples ) const;
 
     void saveSettings(QSettings &pSettings);
 
     void loadSettings(QSettings &pSettings);
 
 private:
+     /** Drops the samples of the previous heap or variable */
+     void reset();
+
      LogVariableItem mLogVariableItem;
-     int mLastHeapSize;
+     // DataRepository::logHeapGeneration() of the samples below
+     uint64_t mHeapGeneration;
+     // Heap window captured on the last tick. In ring buffer mode the
+     // window slides, so samples are addressed by sequence number.
+     uint64_t mLastWriteSequence;
+     uint64_t mFirstSequence;
+     size_t mSize;
+
+     MinMaxPyramid mPyramid;
+     int mViewLevel;     // -1 for raw samples
+     size_t mViewBegin;  // first sample or bucket of the visible slice
+     size_t mViewSize;
+
+     RunningStatistics mStatistics;
+     QPolygonF mNewSamples;     // samples copied in updateBoundingRect
 };
 
 /*
@@ -45,7 +99,17 @@ public:
 
     LogVariableItem logVariableItem();
 
-    void tick();
+    const RunningStatistics& statistics() const;
+
+    /**
+     * Copies the samples drawn for the visible interval of pXMap, for
+     * rendering off the GUI thread.
+     * @return false for curves imported from a file, they are drawn by Qwt
+     */
+    bool visibleSamples( const QwtScaleMap& pXMap, QVector<QPointF>& pSamples ) const;
+
+    /** @return false if the curve did not change since the last tick */
+    bool tick();
 
     void saveSettings(QSettings &pSettings);
 
@@ -53,6 +117,11 @@ public:
 
     virtual QWidget* legendItem() const;
 
+protected:
+    virtual void drawSeries( QPainter* pPainter,
+                             const QwtScaleMap& pXMap, const QwtScaleMap& pYMap,
+                             const QRectF& pCanvasRect, int pFrom, int pTo ) const;
+
 private:
     CurveData *mCurveData;
 };
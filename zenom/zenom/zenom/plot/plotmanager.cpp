@@ -1,4 +1,5 @@
 #include "plotmanager.h"
+#include "utility/tickprofiler.h"
 
 PlotManager::PlotManager(QObject *parent) :
     QObject(parent)
@@ -32,11 +33,12 @@ void PlotManager::loadSettings( QSettings& pSettings )
     pSettings.endGroup();
 }
 
-void PlotManager::tick()
+void PlotManager::tick( const RefreshScheduler& pScheduler )
 {
     for ( int i = 0; i < mPlotList.size(); ++i )
     {
-        mPlotList[i]->tick();
+        TickProfiler::Scope scope( mPlotList[i]->tickSection() );
+        mPlotList[i]->tick( pScheduler );
     }
 }
 
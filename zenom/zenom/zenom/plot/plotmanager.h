@@ -14,7 +14,7 @@ public:
 
     void loadSettings( QSettings& pSettings );
 
-    void tick();
+    void tick( const RefreshScheduler& pScheduler );
 
     void clear();
 
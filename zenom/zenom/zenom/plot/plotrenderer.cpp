@@ -0,0 +1,156 @@
+#include "plotrenderer.h"
+
+#include <QPainter>
+#include <QPolygonF>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <qnumeric.h>
+
+/*
+ *  PlotRenderer::Job
+ */
+class PlotRenderer::Job : public QRunnable
+{
+public:
+    Job( PlotRenderer* pRenderer, const Frame& pFrame )
+        : mRenderer( pRenderer ), mFrame( pFrame ) {}
+
+    virtual void run()
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        QImage image( mFrame.size, QImage::Format_ARGB32_Premultiplied );
+        image.fill( Qt::transparent );
+
+        QPainter painter( &image );
+        for ( int i = 0; i < mFrame.curves.size(); ++i )
+        {
+            const Curve& curve = mFrame.curves[i];
+            QPolygonF polygon;
+            polygon.reserve( curve.steps ? 2 * curve.samples.size() : curve.samples.size() );
+            for ( int j = 0; j < curve.samples.size(); ++j )
+            {
+                const QPointF point( mFrame.xMap.transform( curve.samples[j].x() ),
+                                     mFrame.yMap.transform( curve.samples[j].y() ) );
+                if ( curve.steps && j > 0 )
+                    polygon.push_back( QPointF( point.x(), polygon.last().y() ) );
+                polygon.push_back( point );
+            }
+
+            painter.setRenderHint( QPainter::Antialiasing, curve.antialiased );
+            painter.setPen( curve.pen );
+            painter.drawPolyline( polygon );
+        }
+        painter.end();
+
+        // The renderer waits for mRunning in its destructor, so it is
+        // alive until the lock is released. A queued call still pending
+        // at that time is dropped with the object.
+        QMutexLocker locker( &mRenderer->mMutex );
+        mRenderer->mResult = image;
+        mRenderer->mResultTime = timer.nsecsElapsed() / 1e6;
+        mRenderer->mRunning = false;
+        mRenderer->mFinished.wakeAll();
+        QMetaObject::invokeMethod( mRenderer, "frameRendered", Qt::QueuedConnection );
+    }
+
+private:
+    PlotRenderer* mRenderer;
+    Frame mFrame;
+};
+
+/*
+ *  PlotRenderer
+ */
+PlotRenderer::PlotRenderer( QObject* pParent )
+    : QObject( pParent )
+    , mInFlight( false )
+    , mHasPending( false )
+    , mFrameTime( 0 )
+    , mRunning( false )
+    , mResultTime( 0 )
+{
+
+}
+
+PlotRenderer::~PlotRenderer()
+{
+    QMutexLocker locker( &mMutex );
+    while ( mRunning )
+        mFinished.wait( &mMutex );
+}
+
+void PlotRenderer::render( const Frame& pFrame )
+{
+    if ( mInFlight )
+    {
+        mPending = pFrame;
+        mHasPending = true;
+    }
+    else
+    {
+        start( pFrame );
+    }
+}
+
+void PlotRenderer::start( const Frame& pFrame )
+{
+    mInFlight = true;
+    mRenderingXMap = pFrame.xMap;
+    mRenderingYMap = pFrame.yMap;
+
+    mMutex.lock();
+    mRunning = true;
+    mMutex.unlock();
+
+    QThreadPool::globalInstance()->start( new Job(this, pFrame) );
+}
+
+void PlotRenderer::frameRendered()
+{
+    mMutex.lock();
+    mImage = mResult;
+    mFrameTime = mResultTime;
+    mResult = QImage();
+    mMutex.unlock();
+
+    mImageXMap = mRenderingXMap;
+    mImageYMap = mRenderingYMap;
+    mInFlight = false;
+
+    if ( mHasPending )
+    {
+        mHasPending = false;
+        start( mPending );
+        mPending = Frame();
+    }
+
+    emit frameReady();
+}
+
+void PlotRenderer::draw( QPainter* pPainter, const QwtScaleMap& pXMap, const QwtScaleMap& pYMap ) const
+{
+    if ( mImage.isNull() )
+        return;
+
+    // Scales are linear: image pixel p maps to a + b * p.
+    const double ax = pXMap.transform( mImageXMap.invTransform(0) );
+    const double bx = pXMap.transform( mImageXMap.invTransform(1) ) - ax;
+    const double ay = pYMap.transform( mImageYMap.invTransform(0) );
+    const double by = pYMap.transform( mImageYMap.invTransform(1) ) - ay;
+    if ( !qIsFinite(ax + bx) || !qIsFinite(ay + by) )
+        return;
+
+    pPainter->save();
+    pPainter->setTransform( QTransform(bx, 0, 0, by, ax, ay), true );
+    pPainter->drawImage( 0, 0, mImage );
+    pPainter->restore();
+}
+
+double PlotRenderer::frameTime() const
+{
+    return mFrameTime;
+}
@@ -0,0 +1,94 @@
+#ifndef PLOTRENDERER_H
+#define PLOTRENDERER_H
+
+#include <QObject>
+#include <QImage>
+#include <QPen>
+#include <QVector>
+#include <QPointF>
+#include <QMutex>
+#include <QWaitCondition>
+#include <qwt_scale_map.h>
+
+class QPainter;
+
+/**
+ * Rasterizes the curves of a plot on the global thread pool. The GUI
+ * thread takes a snapshot of the visible samples, and the worker draws
+ * them into an image with the scale maps of the snapshot. The GUI thread
+ * only draws the last finished image.
+ *
+ * Only one frame of a plot is rendered at a time. A frame requested while
+ * another is rendered replaces any frame already waiting, so a slow plot
+ * skips frames instead of falling behind.
+ */
+class PlotRenderer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Curve
+    {
+        QPen pen;
+        bool antialiased;
+        bool steps;     // integer and bool variables hold until the next sample
+        QVector<QPointF> samples;
+    };
+
+    struct Frame
+    {
+        QSize size;
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QVector<Curve> curves;
+    };
+
+    explicit PlotRenderer( QObject* pParent = 0 );
+
+    /** Waits for the frame being rendered. */
+    ~PlotRenderer();
+
+    /** Renders pFrame on a worker thread, frameReady() is emitted when done. */
+    void render( const Frame& pFrame );
+
+    /**
+     * Draws the last rendered image. If the scales changed after the
+     * snapshot, the image is moved and stretched to the given maps until
+     * the next frame is ready.
+     */
+    void draw( QPainter* pPainter, const QwtScaleMap& pXMap, const QwtScaleMap& pYMap ) const;
+
+    /** Render time of the last frame in milliseconds */
+    double frameTime() const;
+
+signals:
+    void frameReady();
+
+private slots:
+    void frameRendered();
+
+private:
+    class Job;
+
+    void start( const Frame& pFrame );
+
+    // GUI thread only
+    bool mInFlight;
+    bool mHasPending;
+    Frame mPending;
+    QwtScaleMap mRenderingXMap;
+    QwtScaleMap mRenderingYMap;
+
+    QImage mImage;
+    QwtScaleMap mImageXMap;
+    QwtScaleMap mImageYMap;
+    double mFrameTime;
+
+    // Shared with the worker
+    QMutex mMutex;
+    QWaitCondition mFinished;
+    bool mRunning;
+    QImage mResult;
+    double mResultTime;
+};
+
+#endif // PLOTRENDERER_H
@@ -5,14 +5,18 @@
 #include <QInputDialog>
 #include <QFileDialog>
 #include <QImageWriter>
+#include <QStatusBar>
 #include "attachlogvariabledialog.h"
+#include "utility/tickprofiler.h"
 
 PlotWindow::PlotWindow(QWidget *parent) :
-    QMainWindow(parent), ui(new Ui::PlotWindow)
+    QMainWindow(parent), ui(new Ui::PlotWindow), mRefreshRate(10)
 {
     ui->setupUi(this);
+    updateProfilerSections();
 
     connect( ui->plot, SIGNAL(autoscaleOff()), this, SLOT(autoscaleOffSlot()) );
+    connect( ui->plot, SIGNAL(frameRendered(double)), this, SLOT(frameRenderedSlot(double)) );
 }
 
 PlotWindow::~PlotWindow()
@@ -20,20 +24,23 @@ PlotWindow::~PlotWindow()
     delete ui;
 }
 
-void PlotWindow::tick()
+void PlotWindow::tick( const RefreshScheduler& pScheduler )
 {
-    ui->plot->tick();
+    if ( mRefreshRate.isDue( pScheduler.now() ) )
+        ui->plot->tick();
 }
 
 void PlotWindow::saveSettings(QSettings &pSettings)
 {
     pSettings.setValue("geometry", saveGeometry());
+    pSettings.setValue("refreshRate", mRefreshRate.rate());
     ui->plot->saveSettings( pSettings );
 }
 
 void PlotWindow::loadSettings(QSettings &pSettings)
 {
     restoreGeometry( pSettings.value("geometry").toByteArray() );
+    mRefreshRate.setRate( pSettings.value("refreshRate", 10).toInt() );
     ui->plot->loadSettings( pSettings );
 }
 
@@ -43,6 +50,24 @@ void PlotWindow::closeEvent(QCloseEvent *pEvent)
     QWidget::closeEvent( pEvent );
 }
 
+bool PlotWindow::event(QEvent *pEvent)
+{
+    if ( pEvent->type() == QEvent::WindowTitleChange )
+        updateProfilerSections();
+
+    // Only update requests, which paint the window, are measured.
+    TickProfiler::Scope scope( pEvent->type() == QEvent::UpdateRequest ?
+                                   mPaintSection : QString() );
+    return QMainWindow::event( pEvent );
+}
+
+void PlotWindow::updateProfilerSections()
+{
+    mTickSection = QString("plot %1").arg( windowTitle() );
+    mPaintSection = QString("plot %1 paint").arg( windowTitle() );
+    mRenderSection = QString("plot %1 render").arg( windowTitle() );
+}
+
 
 void PlotWindow::on_action_Open_triggered()
 {
@@ -83,7 +108,7 @@ void PlotWindow::on_action_Save_triggered()
 void PlotWindow::on_action_Export_triggered()
 {
     QStringList filter;    
-    filter += "Matlab Files (*.m)";
+    filter += "Matlab Files (*.mat)";
 
     const QList<QByteArray> imageFormats =
         QImageWriter::supportedImageFormats();
@@ -117,10 +142,10 @@ void PlotWindow::on_action_Export_triggered()
 
             ui->plot->exportCurvesAsBinary( fileName );
         }
-        else if( selectedFilter == "Matlab Files (*.m)" )   // Matlab File
+        else if( selectedFilter == "Matlab Files (*.mat)" )   // Matlab File
         {
-            if ( !fileName.endsWith(".m") )
-                fileName += ".m";
+            if ( !fileName.endsWith(".mat") )
+                fileName += ".mat";
 
             ui->plot->exportCurvesAsMatlab( fileName );
         }
@@ -172,6 +197,16 @@ void PlotWindow::on_actionSet_Time_Interval_triggered()
     }
 }
 
+void PlotWindow::on_actionSet_Refresh_Rate_triggered()
+{
+    bool isAccepted;
+    int newRate = QInputDialog::getInt ( this, "Set Refresh Rate", "Refresh Rate [Hz]", mRefreshRate.rate(), 1, 60, 1, &isAccepted );
+    if (isAccepted)
+    {
+        mRefreshRate.setRate( newRate );
+    }
+}
+
 void PlotWindow::on_actionAutoscale_triggered(bool pChecked)
 {
     ui->plot->setAutoscale(pChecked);
@@ -181,3 +216,9 @@ void PlotWindow::autoscaleOffSlot()
 {
     ui->actionAutoscale->setChecked( false );
 }
+
+void PlotWindow::frameRenderedSlot( double pTime )
+{
+    TickProfiler::instance()->record( mRenderSection, pTime );
+    statusBar()->showMessage( QString("Frame: %1 ms").arg(pTime, 0, 'f', 1) );
+}
@@ -3,6 +3,7 @@
 
 #include <QMainWindow>
 #include <QSettings>
+#include "utility/refreshscheduler.h"
 
 namespace Ui {
 class PlotWindow;
@@ -17,17 +18,22 @@ public:
 
     ~PlotWindow();
 
-    void tick();
+    /** Updates the plot if it is due. */
+    void tick( const RefreshScheduler& pScheduler );
 
     void saveSettings( QSettings& pSettings );
 
     void loadSettings( QSettings& pSettings );
 
+    /** TickProfiler section of tick(), follows the window title */
+    const QString& tickSection() const { return mTickSection; }
+
 signals:
     void closed( PlotWindow* ) ;
 
 protected:
     virtual void closeEvent(QCloseEvent *pEvent);
+    virtual bool event(QEvent *pEvent);
 
 private slots:
     void on_action_Open_triggered();
@@ -42,12 +48,23 @@ private slots:
     
     void on_actionSet_Time_Interval_triggered();
 
+    void on_actionSet_Refresh_Rate_triggered();
+
     void on_actionAutoscale_triggered(bool pChecked);
 
     void autoscaleOffSlot();
 
+    void frameRenderedSlot( double pTime );
+
 private:
     Ui::PlotWindow *ui;
+    RefreshRate mRefreshRate;
+
+    QString mTickSection;
+    QString mPaintSection;
+    QString mRenderSection;
+
+    void updateProfilerSections();
 };
 
 #endif // PLOTWINDOW_H
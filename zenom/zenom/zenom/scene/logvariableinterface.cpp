@@ -9,6 +9,7 @@ LogVariableInterface::LogVariableInterface()
 void LogVariableInterface::setLogVariable( LogVariable* pLogVariable )
 {
 	mLogVariable = pLogVariable;
+	mSample.assign( pLogVariable ? pLogVariable->size() + 1 : 0, 0.0 );
 }
 
 LogVariable* LogVariableInterface::logVariable()
@@ -16,76 +17,87 @@ LogVariable* LogVariableInterface::logVariable()
 	return mLogVariable;
 }
 
+const double* LogVariableInterface::lastSample()
+{
+	mLogVariable->copyLastHeapElement( mSample.data() );
+	return mSample.data();
+}
+
 LogVariableInterface::operator unsigned short()
 {
-	unsigned short us = mLogVariable->lastHeapElement()[0];
+	unsigned short us = lastSample()[0];
 	return us;
 }
 
 LogVariableInterface::operator bool()
 {
-	bool b = mLogVariable->lastHeapElement()[0];
+	bool b = lastSample()[0];
 	return b;
 }
 
 LogVariableInterface::operator int()
 {
-	int i = mLogVariable->lastHeapElement()[0];
+	int i = lastSample()[0];
 	return i;
 }
 
 LogVariableInterface::operator float()
 {
-	float f = mLogVariable->lastHeapElement()[0];
+	float f = lastSample()[0];
 	return f;
 }
 
 LogVariableInterface::operator const osg::Vec3()
 {
+	const double* sample = lastSample();
 	osg::Vec3 vec;
-	vec.x() = mLogVariable->lastHeapElement()[0];
-	vec.y() = mLogVariable->lastHeapElement()[1];
-	vec.z() = mLogVariable->lastHeapElement()[2];
+	vec.x() = sample[0];
+	vec.y() = sample[1];
+	vec.z() = sample[2];
 	return vec;
 }
 
 LogVariableInterface::operator const osg::Vec3d()
 {
+	const double* sample = lastSample();
 	osg::Vec3d vec;
-	vec.x() = mLogVariable->lastHeapElement()[0];
-	vec.y() = mLogVariable->lastHeapElement()[1];
-	vec.z() = mLogVariable->lastHeapElement()[2];
+	vec.x() = sample[0];
+	vec.y() = sample[1];
+	vec.z() = sample[2];
 	return vec;
 }
 
 LogVariableInterface::operator const osg::Vec4()
 {
+	const double* sample = lastSample();
 	osg::Vec4 vec;
-	vec.x() = mLogVariable->lastHeapElement()[0];
-	vec.y() = mLogVariable->lastHeapElement()[1];
-	vec.z() = mLogVariable->lastHeapElement()[2];
-	vec.w() = mLogVariable->lastHeapElement()[3];
+	vec.x() = sample[0];
+	vec.y() = sample[1];
+	vec.z() = sample[2];
+	vec.w() = sample[3];
 	return vec;
 }
 
 LogVariableInterface::operator const osg::Quat()
 {
+	const double* sample = lastSample();
 	osg::Quat quat;
-	quat.x() = mLogVariable->lastHeapElement()[0];
-	quat.y() = mLogVariable->lastHeapElement()[1];
-	quat.z() = mLogVariable->lastHeapElement()[2];
-	quat.w() = mLogVariable->lastHeapElement()[3];
+	quat.x() = sample[0];
+	quat.y() = sample[1];
+	quat.z() = sample[2];
+	quat.w() = sample[3];
 	return quat;
 }
 
 LogVariableInterface::operator osg::Vec3Array*()
 {
+	const double* sample = lastSample();
 	osg::Vec3Array* vecs = new osg::Vec3Array();
     for ( unsigned int i = 0; i < mLogVariable->size() - 2; i = i + 3 )
 	{
-		vecs->push_back(osg::Vec3d(mLogVariable->lastHeapElement()[i],
-			mLogVariable->lastHeapElement()[i+1], 
-			mLogVariable->lastHeapElement()[i+2]));
+		vecs->push_back(osg::Vec3d(sample[i],
+			sample[i+1], 
+			sample[i+2]));
 	}
 
 	return vecs;
@@ -93,13 +105,14 @@ LogVariableInterface::operator osg::Vec3Array*()
 
 LogVariableInterface::operator osg::Vec4Array*()
 {
+	const double* sample = lastSample();
     osg::Vec4Array* vecs = new osg::Vec4Array();
     for ( unsigned int i = 0; i < mLogVariable->size() - 3; i = i + 4 )
     {
-        vecs->push_back(osg::Vec4d(mLogVariable->lastHeapElement()[i],
-            mLogVariable->lastHeapElement()[i+1],
-            mLogVariable->lastHeapElement()[i+2],
-            mLogVariable->lastHeapElement()[i+3]));
+        vecs->push_back(osg::Vec4d(sample[i],
+            sample[i+1],
+            sample[i+2],
+            sample[i+3]));
     }
 
     return vecs;
@@ -107,10 +120,11 @@ LogVariableInterface::operator osg::Vec4Array*()
 
 LogVariableInterface::operator osg::IndexArray*()
 {
+	const double* sample = lastSample();
 	osg::UIntArray* arr = new osg::UIntArray();
     for ( unsigned int i = 0; i < mLogVariable->size(); ++i )
 	{
-		arr->push_back(mLogVariable->lastHeapElement()[i]);
+		arr->push_back(sample[i]);
 	}
 
 	return arr;
@@ -118,28 +132,29 @@ LogVariableInterface::operator osg::IndexArray*()
 
 LogVariableInterface::operator const osg::Matrix()
 {
+	const double* sample = lastSample();
 	osg::Matrix matrix;
-	matrix.set( mLogVariable->lastHeapElement() );
+	matrix.set( sample );
 	return matrix;
 }
 
 LogVariableInterface::operator GLenum()
 {
-    return (GLenum)mLogVariable->lastHeapElement()[0];
+    return (GLenum)lastSample()[0];
 }
 
 LogVariableInterface::operator osg::AutoTransform::AutoRotateMode()
 {
-    return (osg::AutoTransform::AutoRotateMode)mLogVariable->lastHeapElement()[0];
+    return (osg::AutoTransform::AutoRotateMode)lastSample()[0];
 }
 
 LogVariableInterface::operator osgSim::DOFTransform::MultOrder()
 {
-    return (osgSim::DOFTransform::MultOrder)mLogVariable->lastHeapElement()[0];
+    return (osgSim::DOFTransform::MultOrder)lastSample()[0];
 }
 
 LogVariableInterface::operator osg::Geometry::AttributeBinding()
 {
-    return (osg::Geometry::AttributeBinding)mLogVariable->lastHeapElement()[0];
+    return (osg::Geometry::AttributeBinding)lastSample()[0];
 }
 
@@ -13,6 +13,7 @@
 #include <osg/Geometry>
 
 #include <logvariable.h>
+#include <vector>
 
 class LogVariableInterface
 {
@@ -57,7 +58,14 @@ public:
     operator osg::Geometry::AttributeBinding();
 
 private:
+	/**
+	 * Son ornegin tutarli bir kopyasini alir. Donusumlerdeki butun
+	 * elemanlar ayni ornekten okunur.
+	 */
+	const double* lastSample();
+
 	LogVariable* mLogVariable;
+	std::vector<double> mSample;
 };
 
 #endif	// LOGVARIABLEINTERFACE_H
@@ -1,4 +1,5 @@
 #include "scenemanager.h"
+#include "utility/tickprofiler.h"
 
 SceneManager::SceneManager(QWidget *pParent)
 	: QObject(pParent)
@@ -38,11 +39,12 @@ void SceneManager::loadSettings( QSettings& pSettings )
 	pSettings.endGroup();
 }
 
-void SceneManager::tick()
+void SceneManager::tick( const RefreshScheduler& pScheduler )
 {
 	for ( int i = 0; i < mSceneList.size(); ++i )
 	{
-		mSceneList[i]->tick();
+		TickProfiler::Scope scope( mSceneList[i]->tickSection() );
+		mSceneList[i]->tick( pScheduler );
 	}
 }
 
@@ -7,12 +7,18 @@
 #include <QFileInfo>
 #include <osgDB/Registry>
 #include <osgDB/ReadFile>
+#include "utility/tickprofiler.h"
 
 SceneWindow::SceneWindow(QWidget *parent) :
     QMainWindow(parent),
-    ui(new Ui::SceneWindow)
+    ui(new Ui::SceneWindow),
+    mRefreshRate(30),
+    mInputPending(true),
+    mInputFrames(0)
 {
     ui->setupUi(this);
+    ui->viewer->installEventFilter( this );
+    updateProfilerSections();
 
     // Viewpoints combo box
     mViewpointsComboBox = new QComboBox();
@@ -33,15 +39,51 @@ SceneWindow::~SceneWindow()
 }
 
 
-void SceneWindow::tick()
+void SceneWindow::tick( const RefreshScheduler& pScheduler )
 {
-    ui->viewer->update();
+    if ( !mRefreshRate.isDue( pScheduler.now() ) )
+        return;
+
+    // Camera manipulators keep moving for a while after the input.
+    if ( mInputPending )
+    {
+        mInputPending = false;
+        mInputFrames = mRefreshRate.rate();
+    }
+
+    if ( pScheduler.hasChanges() || mInputFrames > 0 )
+    {
+        ui->viewer->update();
+        if ( mInputFrames > 0 )
+            --mInputFrames;
+    }
+}
+
+bool SceneWindow::eventFilter( QObject* pObject, QEvent* pEvent )
+{
+    switch ( pEvent->type() )
+    {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+    case QEvent::Resize:
+        mInputPending = true;
+        break;
+    default:
+        break;
+    }
+    return QMainWindow::eventFilter( pObject, pEvent );
 }
 
 void SceneWindow::saveSettings(QSettings &pSettings)
 {
     pSettings.setValue("geometry", saveGeometry());
     pSettings.setValue("filename", mSceneFilename);
+    pSettings.setValue("refreshRate", mRefreshRate.rate());
     pSettings.setValue("viewpointSize", mViewpoints.size());
     int i = 0;
     QMap<QString, Viewpoint>::iterator itr = mViewpoints.begin();
@@ -59,6 +101,7 @@ void SceneWindow::saveSettings(QSettings &pSettings)
 void SceneWindow::loadSettings(QSettings &pSettings)
 {
     restoreGeometry( pSettings.value("geometry").toByteArray() );
+    mRefreshRate.setRate( pSettings.value("refreshRate", 30).toInt() );
     readNodeFile( pSettings.value("filename").toString() );
     int size = pSettings.value("viewpointSize", 0).toInt();
     for ( int i = 0; i < size; ++i )
@@ -78,6 +121,23 @@ void SceneWindow::closeEvent(QCloseEvent *pEvent)
     QWidget::closeEvent( pEvent );
 }
 
+bool SceneWindow::event(QEvent *pEvent)
+{
+    if ( pEvent->type() == QEvent::WindowTitleChange )
+        updateProfilerSections();
+
+    // Only update requests, which paint the window, are measured.
+    TickProfiler::Scope scope( pEvent->type() == QEvent::UpdateRequest ?
+                                   mPaintSection : QString() );
+    return QMainWindow::event( pEvent );
+}
+
+void SceneWindow::updateProfilerSections()
+{
+    mTickSection = QString("scene %1").arg( windowTitle() );
+    mPaintSection = QString("scene %1 paint").arg( windowTitle() );
+}
+
 // File Menu
 void SceneWindow::on_actionOpen_triggered()
 {
@@ -106,6 +166,7 @@ void SceneWindow::viewpointChangedSlot( const QString& pName )
     {
         Viewpoint viewpoint = itr.value();
         ui->viewer->getCameraManipulator()->setByMatrix( viewpoint.matrix() );
+        mInputPending = true;
     }
 }
 
@@ -214,6 +275,7 @@ void SceneWindow::readNodeFile(const QString &pFilename)
             clear();    // Clear
 
             ui->viewer->setSceneData( loadedModel );
+            mInputPending = true;
             insertViewpoint( Viewpoint( "Default", ui->viewer->getCameraManipulator()->getMatrix()) );
 
             mBindDialog->setSceneData( loadedModel );
@@ -8,6 +8,7 @@
 
 #include "binddialog.h"
 #include "viewpoint.h"
+#include "utility/refreshscheduler.h"
 
 namespace Ui {
 class SceneWindow;
@@ -22,12 +23,19 @@ public:
 
     ~SceneWindow();
 
-    void tick();
+    /**
+     * Redraws the scene if it is due and a log variable changed, or the
+     * user interacted with the view in the last second.
+     */
+    void tick( const RefreshScheduler& pScheduler );
 
     void saveSettings( QSettings& pSettings );
 
     void loadSettings( QSettings& pSettings );
 
+    /** TickProfiler section of tick(), follows the window title */
+    const QString& tickSection() const { return mTickSection; }
+
 signals:
     void closed( SceneWindow* ) ;
 
@@ -35,6 +43,9 @@ signals:
 
 protected:
     virtual void closeEvent(QCloseEvent *pEvent);
+    virtual bool event(QEvent *pEvent);
+
+    virtual bool eventFilter( QObject* pObject, QEvent* pEvent );
 
 private slots:
     // File Menu
@@ -58,6 +69,15 @@ private:
     BindDialog* mBindDialog;
     QString mSceneFilename;
 
+    RefreshRate mRefreshRate;
+    bool mInputPending;     // view changed by the user since the last tick
+    int mInputFrames;       // frames left to draw after an input
+
+    QString mTickSection;
+    QString mPaintSection;
+
+    void updateProfilerSections();
+
     void readNodeFile( const QString& pFilename );
 
     void insertViewpoint( const Viewpoint& pViewpoint );
@@ -43,6 +43,7 @@ int TargetUI::doloop(){
         for (const auto i : input_lookup){
             cntrVariables[i.varIndex]->setHeapElement(i.row, i.col, selectedBoard->target->getInput(i.targetID));
         }
+        DataRepository::instance()->commitControlVariables();
 
         for (const auto i : output_lookup){
             if(logVariables[i.varIndex]->isHeapValid()){
@@ -97,6 +98,7 @@ void TargetUI::sendStateRequest(StateRequest pRequest)
         for (const auto i : input_lookup){
             cntrVariables[i.varIndex]->setHeapElement(i.row, i.col, 0);
         }
+        DataRepository::instance()->commitControlVariables();
     }
     else if(pRequest == R_TERMINATE){
         state = TERMINATED;
@@ -0,0 +1,66 @@
+#include "binaryexporter.h"
+#include <QFile>
+#include <QDataStream>
+#include <algorithm>
+#include <vector>
+
+// Samples gathered from the heap per write
+static const size_t BLOCK_SIZE = 32 * 1024;
+
+BinaryExporter::BinaryExporter( const QString& pFileName, QObject* pParent )
+    : Exporter( pFileName, pParent )
+{
+
+}
+
+void BinaryExporter::addLogVariableItem( const QString& pName, LogVariable* pLogVariable,
+                                         unsigned int pRow, unsigned int pColumn )
+{
+    Item item = { pName, pLogVariable, (int)(pRow * pLogVariable->col() + pColumn) };
+    mItems.push_back( item );
+}
+
+bool BinaryExporter::write()
+{
+    QFile file( fileName() );
+    if ( !file.open(QIODevice::WriteOnly) )
+        return false;
+
+    // Ring buffer modunda pencere kayabilir, aralik bastan alinir.
+    QList<uint64_t> firsts, lasts;
+    uint64_t totalSamples = 0;
+    for ( int i = 0; i < mItems.size(); ++i )
+    {
+        LogVariable* logVariable = mItems[i].logVariable;
+        const bool valid = logVariable->isHeapValid();
+        firsts.push_back( valid ? logVariable->firstSequence() : 0 );
+        lasts.push_back( valid ? logVariable->writeSequence() : 0 );
+        totalSamples += lasts.back() - firsts.back();
+    }
+    setTotalSamples( totalSamples );
+
+    // The stream layout of QVector<QPointF>: the size, then x and y of
+    // every point.
+    QDataStream out( &file );
+    std::vector<double> block( 2 * BLOCK_SIZE );
+    for ( int i = 0; i < mItems.size() && !isCanceled(); ++i )
+    {
+        LogVariable* logVariable = mItems[i].logVariable;
+        out << mItems[i].name << quint32( lasts[i] - firsts[i] );
+
+        for ( uint64_t sequence = firsts[i]; sequence < lasts[i] && !isCanceled(); )
+        {
+            const size_t size = std::min<uint64_t>( lasts[i] - sequence, BLOCK_SIZE );
+            logVariable->copyHeapSamples( sequence, size, mItems[i].index, block.data() );
+            for ( size_t j = 0; j < 2 * size; ++j )
+            {
+                out << block[j];
+            }
+            addProgress( size );
+            sequence += size;
+        }
+    }
+
+    file.close();
+    return out.status() == QDataStream::Ok && file.error() == QFile::NoError;
+}
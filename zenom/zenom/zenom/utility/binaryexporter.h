@@ -0,0 +1,39 @@
+#ifndef BINARYEXPORTER_H
+#define BINARYEXPORTER_H
+
+#include <QString>
+#include <QList>
+#include <logvariable.h>
+#include "exporter.h"
+
+/**
+ * Plot egrilerini arka planda QDataStream dosyasina yazar. Dosya her egri
+ * icin egrinin ismini ve QVector<QPointF> (zaman, deger) dizisini icerir;
+ * Plot::importCurvesFromText ile geri okunur. Ornekler heap'ten bloklar
+ * halinde okunup yazilir, dizi bellekte olusturulmaz.
+ */
+class BinaryExporter : public Exporter
+{
+    Q_OBJECT
+public:
+    BinaryExporter( const QString& pFileName, QObject* pParent = 0 );
+
+    /** Degiskenin bir elemanini pName isimli egri olarak export listesine ekler. */
+    void addLogVariableItem( const QString& pName, LogVariable* pLogVariable,
+                             unsigned int pRow, unsigned int pColumn );
+
+protected:
+    bool write();
+
+private:
+    struct Item
+    {
+        QString name;
+        LogVariable* logVariable;
+        int index;      // degiskenin eleman indeksi
+    };
+
+    QList<Item> mItems;
+};
+
+#endif // BINARYEXPORTER_H
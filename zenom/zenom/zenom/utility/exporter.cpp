@@ -0,0 +1,93 @@
+#include "exporter.h"
+#include <QProgressDialog>
+#include <QEventLoop>
+#include <QPointer>
+#include <QFile>
+#include <datarepository.h>
+
+Exporter::Exporter( const QString& pFileName, QObject* pParent )
+    : QThread( pParent )
+    , mFileName( pFileName )
+    , mSucceeded( false )
+    , mCanceled( false )
+    , mTotalSamples( 0 )
+    , mWrittenSamples( 0 )
+    , mPercent( 0 )
+{
+
+}
+
+bool Exporter::exec( QWidget* pParent )
+{
+    // The dialog blocks every window from the start. It is deleted with
+    // pParent if the window is destroyed while the loop runs.
+    QPointer<QProgressDialog> progress =
+            new QProgressDialog( tr("Exporting %1...").arg(mFileName), tr("Cancel"), 0, 100, pParent );
+    progress->setWindowModality( Qt::ApplicationModal );
+    progress->setMinimumDuration( 0 );
+    progress->setValue( 0 );
+    connect( this, SIGNAL(progressChanged(int)), progress, SLOT(setValue(int)) );
+    connect( progress, SIGNAL(canceled()), this, SLOT(cancel()), Qt::DirectConnection );
+
+    QEventLoop loop;
+    connect( this, SIGNAL(finished()), &loop, SLOT(quit()) );
+    mCanceled = false;
+    start( QThread::LowPriority );
+    loop.exec();
+
+    // The loop also returns when the application quits.
+    cancel();
+    wait();
+    delete progress;
+
+    return mSucceeded;
+}
+
+bool Exporter::isCanceled() const
+{
+    return mCanceled.load( std::memory_order_relaxed ) ||
+            DataRepository::instance()->isLogHeapReleaseRequested();
+}
+
+const QString& Exporter::fileName() const
+{
+    return mFileName;
+}
+
+void Exporter::cancel()
+{
+    mCanceled.store( true, std::memory_order_relaxed );
+}
+
+void Exporter::setTotalSamples( uint64_t pSamples )
+{
+    mTotalSamples = pSamples;
+}
+
+void Exporter::addProgress( uint64_t pSamples )
+{
+    mWrittenSamples += pSamples;
+    int percent = mTotalSamples ? (int)(100 * mWrittenSamples / mTotalSamples) : 100;
+    if ( percent != mPercent )
+    {
+        mPercent = percent;
+        emit progressChanged( qMin(percent, 100) );
+    }
+}
+
+void Exporter::run()
+{
+    mTotalSamples = 0;
+    mWrittenSamples = 0;
+    mPercent = 0;
+
+    // The heap is not deleted while it is held.
+    const bool held = DataRepository::instance()->acquireLogHeap();
+    mSucceeded = write() && !isCanceled();
+    if ( held )
+        DataRepository::instance()->releaseLogHeap();
+
+    // Yarim kalan dosya birakilmaz.
+    if ( !mSucceeded )
+        QFile::remove( mFileName );
+}
@@ -0,0 +1,74 @@
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include <QThread>
+#include <QString>
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * Arka planda dosyaya export eden thread'lerin ortak kismi. Alt siniflar
+ * write() icinde heap'i bloklar halinde okuyup dogrudan dosyaya yazar,
+ * boylece export edilen veri bellekte ikinci kez tutulmaz.
+ *
+ * exec() uygulama modal bir ilerleme penceresi gosterir; export bitene
+ * kadar Start, proje kapatma ve pencere kapatma kullanilamaz. Pencerenin
+ * Cancel butonu export'u bir sonraki blokta durdurur ve yarim kalan dosya
+ * silinir.
+ *
+ * Thread yazarken log heap'ini DataRepository::acquireLogHeap() ile
+ * tutar. Heap yine de silinmek istenirse (control process'in cokmesi
+ * gibi) export iptal edilir ve heap birakildiktan sonra silinir.
+ */
+class Exporter : public QThread
+{
+    Q_OBJECT
+public:
+    Exporter( const QString& pFileName, QObject* pParent = 0 );
+
+    /**
+     * Export'u baslatir ve bitene kadar bir ilerleme penceresi gosterir.
+     * Pencere acikken arayuz cizilmeye devam eder.
+     * @return dosya yazilamaz veya export iptal edilir ise false
+     */
+    bool exec( QWidget* pParent );
+
+    /** Export kullanici tarafindan veya heap silindigi icin iptal edildi ise true */
+    bool isCanceled() const;
+
+    const QString& fileName() const;
+
+public slots:
+    /** Export'u bir sonraki blokta durdurur, herhangi bir thread'den cagrilabilir. */
+    void cancel();
+
+signals:
+    void progressChanged( int pPercent );
+
+protected:
+    /**
+     * Dosyayi yazar ve kapatir. Uzun donguler isCanceled()'a bakarak
+     * erken donmelidir.
+     * @return dosya eksiksiz yazildi ise true
+     */
+    virtual bool write() = 0;
+
+    /** Ilerleme yuzdesinin hesaplandigi toplam ornek sayisi */
+    void setTotalSamples( uint64_t pSamples );
+
+    /** pSamples ornek yazildi, yuzde degisti ise progressChanged yayilir. */
+    void addProgress( uint64_t pSamples );
+
+    void run();
+
+private:
+    QString mFileName;
+    bool mSucceeded;
+    std::atomic<bool> mCanceled;
+
+    uint64_t mTotalSamples;
+    uint64_t mWrittenSamples;
+    int mPercent;
+};
+
+#endif // EXPORTER_H
@@ -0,0 +1,121 @@
+#include "matfilewriter.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <limits>
+
+// MAT-File Format, Level 5 data types and array classes
+enum
+{
+    miINT8 = 1,
+    miINT32 = 5,
+    miUINT32 = 6,
+    miDOUBLE = 9,
+    miMATRIX = 14,
+    mxDOUBLE_CLASS = 6
+};
+
+MatFileWriter::MatFileWriter()
+{
+
+}
+
+bool MatFileWriter::open( const std::string& pFileName )
+{
+    mFile.open( pFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !mFile.is_open() )
+        return false;
+
+    // 116 byte descriptive text, 8 byte subsystem offset, version, endian
+    char header[128];
+    std::memset( header, ' ', 116 );
+    std::time_t now = std::time( nullptr );
+    char text[117];
+    int length = std::snprintf( text, sizeof(text),
+                                "MATLAB 5.0 MAT-file, Platform: zenom, Created on: %s",
+                                std::ctime(&now) );
+    if ( length > 0 )
+        std::memcpy( header, text, std::min<size_t>(length - 1, 116) ); // no '\n'
+    std::memset( header + 116, 0, 8 );
+
+    const uint16_t version = 0x0100;
+    std::memcpy( header + 124, &version, 2 );
+    header[126] = 'I';
+    header[127] = 'M';
+    mFile.write( header, sizeof(header) );
+
+    return mFile.good();
+}
+
+void MatFileWriter::close()
+{
+    mFile.close();
+}
+
+bool MatFileWriter::good()
+{
+    return mFile.good();
+}
+
+bool MatFileWriter::beginArray( const std::string& pName,
+                                const std::vector<uint32_t>& pDims )
+{
+    uint64_t count = 1;
+    for ( size_t i = 0; i < pDims.size(); ++i )
+        count *= pDims[i];
+
+    const uint32_t dimsBytes = pDims.size() * sizeof(int32_t);
+    const uint32_t dimsPadding = (8 - dimsBytes % 8) % 8;
+    const uint32_t nameBytes = pName.size();
+    const uint32_t namePadding = (8 - nameBytes % 8) % 8;
+
+    // array flags, dimensions, name and real part sub-elements
+    const uint64_t bytes = (8 + 8)
+            + (8 + dimsBytes + dimsPadding)
+            + (8 + nameBytes + namePadding)
+            + (8 + count * sizeof(double));
+
+    // Level 5 element sizes are 32 bit.
+    if ( bytes > std::numeric_limits<uint32_t>::max() )
+        return false;
+
+    writeTag( miMATRIX, bytes );
+
+    writeTag( miUINT32, 8 );
+    const uint32_t flags[2] = { mxDOUBLE_CLASS, 0 };
+    mFile.write( (const char*)flags, sizeof(flags) );
+
+    writeTag( miINT32, dimsBytes );
+    for ( size_t i = 0; i < pDims.size(); ++i )
+    {
+        const int32_t dim = pDims[i];
+        mFile.write( (const char*)&dim, sizeof(dim) );
+    }
+    writePadding( dimsPadding );
+
+    writeTag( miINT8, nameBytes );
+    mFile.write( pName.c_str(), nameBytes );
+    writePadding( namePadding );
+
+    writeTag( miDOUBLE, count * sizeof(double) );
+
+    return mFile.good();
+}
+
+void MatFileWriter::writeData( const double* pData, size_t pCount )
+{
+    mFile.write( (const char*)pData, pCount * sizeof(double) );
+}
+
+void MatFileWriter::writeTag( uint32_t pType, uint32_t pBytes )
+{
+    const uint32_t tag[2] = { pType, pBytes };
+    mFile.write( (const char*)tag, sizeof(tag) );
+}
+
+void MatFileWriter::writePadding( uint32_t pBytes )
+{
+    static const char zeros[8] = { 0 };
+    mFile.write( zeros, pBytes );
+}
@@ -0,0 +1,49 @@
+#ifndef MATFILEWRITER_H
+#define MATFILEWRITER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * Matlab'in Level 5 MAT dosya formatinda (load ile okunur) double
+ * diziler yazar. Dizilerin boyutu bastan bilindigi icin veriler
+ * bellekte toplanmadan parca parca dosyaya yazilabilir.
+ */
+class MatFileWriter
+{
+public:
+    MatFileWriter();
+
+    /**
+     * Dosyayi olusturur ve 128 byte'lik MAT basligini yazar.
+     * @return dosya olusturulamaz ise false
+     */
+    bool open( const std::string& pFileName );
+
+    void close();
+
+    bool good();
+
+    /**
+     * Yeni bir double dizi baslatir. Ardindan dizinin butun elemanlari
+     * Matlab sirasinda (ilk boyut en hizli degisir) writeData ile
+     * yazilmalidir.
+     * @param pName Matlab degisken ismi
+     * @param pDims dizinin boyutlari, en az iki tane
+     * @return dizi bir MAT elemanina sigmayacak kadar buyuk ise false
+     */
+    bool beginArray( const std::string& pName, const std::vector<uint32_t>& pDims );
+
+    void writeData( const double* pData, size_t pCount );
+
+private:
+    void writeTag( uint32_t pType, uint32_t pBytes );
+
+    void writePadding( uint32_t pBytes );
+
+    std::ofstream mFile;
+};
+
+#endif // MATFILEWRITER_H
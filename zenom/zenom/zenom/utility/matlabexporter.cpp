@@ -0,0 +1,139 @@
+#include "matlabexporter.h"
+#include <QSet>
+#include <algorithm>
+
+// Samples gathered from the heap per write
+static const size_t BLOCK_SIZE = 64 * 1024;
+
+MatlabExporter::MatlabExporter( const QString& pFileName, QObject* pParent )
+    : Exporter( pFileName, pParent )
+{
+
+}
+
+void MatlabExporter::addLogVariable( LogVariable* pLogVariable )
+{
+    Item item = { pLogVariable, -1, -1 };
+    mItems.push_back( item );
+}
+
+void MatlabExporter::addLogVariableItem( LogVariable* pLogVariable,
+                                         unsigned int pRow, unsigned int pColumn )
+{
+    Item item = { pLogVariable, (int)pRow, (int)pColumn };
+    mItems.push_back( item );
+}
+
+bool MatlabExporter::write()
+{
+    if ( !mWriter.open( fileName().toStdString() ) )
+        return false;
+
+    uint64_t totalSamples = 0;
+    for ( int i = 0; i < mItems.size(); ++i )
+    {
+        LogVariable* logVariable = mItems[i].logVariable;
+        if ( logVariable->isHeapValid() )
+        {
+            unsigned int elements = mItems[i].row < 0 ? logVariable->size() : 1;
+            totalSamples += logVariable->heapSize() * (elements + 1);
+        }
+    }
+    setTotalSamples( totalSamples );
+
+    bool succeeded = true;
+    QSet<QString> timeNames;
+    for ( int i = 0; i < mItems.size() && succeeded; ++i )
+    {
+        LogVariable* logVariable = mItems[i].logVariable;
+        if ( !logVariable->isHeapValid() )
+            continue;
+
+        // Ring buffer modunda pencere kayabilir, sequence ile okunur.
+        const uint64_t first = logVariable->firstSequence();
+        const uint64_t last = logVariable->writeSequence();
+        const uint32_t count = last - first;
+        const QString name = QString::fromStdString( logVariable->name() );
+        const unsigned int rows = logVariable->row();
+        const unsigned int cols = logVariable->col();
+
+        if ( mItems[i].row < 0 )
+        {
+            // Matlab diziyi sutun sutun okur, ilk boyut ornek sayisidir.
+            std::vector<uint32_t> dims;
+            dims.push_back( count );
+            if ( rows == 1 || cols == 1 )   // Variable or Vector
+            {
+                dims.push_back( rows * cols );
+            }
+            else    // Matrices
+            {
+                dims.push_back( rows );
+                dims.push_back( cols );
+            }
+
+            succeeded = mWriter.beginArray( name.toStdString(), dims );
+            for ( unsigned int c = 0; c < cols && succeeded; ++c )
+            {
+                for ( unsigned int r = 0; r < rows && succeeded; ++r )
+                {
+                    succeeded = writeElement( logVariable, first, last, r * cols + c );
+                }
+            }
+        }
+        else
+        {
+            const int row = mItems[i].row;
+            const int column = mItems[i].column;
+
+            QString itemName = name;
+            if ( rows == 1 && cols == 1 ) // Variable
+                itemName = name;
+            else if ( rows == 1 || cols == 1 ) // Vector
+                itemName = QString("%1_%2").arg( name ).arg( rows == 1 ? column+1 : row+1 );
+            else    // Matrices
+                itemName = QString("%1_%2_%3").arg( name ).arg( row+1 ).arg( column+1 );
+
+            std::vector<uint32_t> dims;
+            dims.push_back( count );
+            dims.push_back( 1 );
+            succeeded = mWriter.beginArray( itemName.toStdString(), dims ) &&
+                         writeElement( logVariable, first, last, row * cols + column );
+        }
+
+        // Degisken ismi log variable ismine _t eklenerek olusturulur.
+        const QString timeName = QString("%1_t").arg( name );
+        if ( succeeded && !timeNames.contains(timeName) )
+        {
+            timeNames.insert( timeName );
+
+            std::vector<uint32_t> dims;
+            dims.push_back( count );
+            dims.push_back( 1 );
+            succeeded = mWriter.beginArray( timeName.toStdString(), dims ) &&
+                         writeElement( logVariable, first, last, -1 );
+        }
+    }
+
+    mWriter.close();
+    mBlock = std::vector<double>();
+    return succeeded;
+}
+
+bool MatlabExporter::writeElement( LogVariable* pLogVariable,
+                                   uint64_t pFirst, uint64_t pLast, int pIndex )
+{
+    mBlock.resize( BLOCK_SIZE );
+
+    const int index = pIndex < 0 ? (int)pLogVariable->size() : pIndex;
+    for ( uint64_t i = pFirst; i < pLast && !isCanceled(); )
+    {
+        const size_t size = std::min<uint64_t>( pLast - i, mBlock.size() );
+        pLogVariable->copyHeapColumn( i, size, index, mBlock.data() );
+        mWriter.writeData( mBlock.data(), size );
+        addProgress( size );
+        i += size;
+    }
+
+    return mWriter.good() && !isCanceled();
+}
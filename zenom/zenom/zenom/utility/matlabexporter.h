@@ -0,0 +1,53 @@
+#ifndef MATLABEXPORTER_H
+#define MATLABEXPORTER_H
+
+#include <QString>
+#include <QList>
+#include <logvariable.h>
+#include "exporter.h"
+#include "matfilewriter.h"
+
+/**
+ * Log degiskenlerini arka planda MAT (.mat) dosyasina yazar. Degerler
+ * heap'ten bloklar halinde toplanip dogrudan double olarak yazilir.
+ *
+ * Degisken isimleri eski Matlab export'u ile aynidir: degiskenin zamani
+ * isim_t, degerleri isim (vektorler N x boyut, matrisler N x satir x
+ * sutun dizisi). Tek bir elemani export edilen degiskenler isim_i veya
+ * isim_i_j olarak yazilir.
+ */
+class MatlabExporter : public Exporter
+{
+    Q_OBJECT
+public:
+    MatlabExporter( const QString& pFileName, QObject* pParent = 0 );
+
+    /** Degiskenin butun elemanlarini ve zamanini export listesine ekler. */
+    void addLogVariable( LogVariable* pLogVariable );
+
+    /** Degiskenin bir elemanini ve zamanini export listesine ekler. */
+    void addLogVariableItem( LogVariable* pLogVariable,
+                             unsigned int pRow, unsigned int pColumn );
+
+protected:
+    bool write();
+
+private:
+    struct Item
+    {
+        LogVariable* logVariable;
+        int row;        // -1 ise butun degisken
+        int column;
+    };
+
+    /** Degiskenin [pFirst, pLast) sequence araligindaki bir elemanini yazar. */
+    bool writeElement( LogVariable* pLogVariable, uint64_t pFirst, uint64_t pLast,
+                       int pIndex );
+
+    QList<Item> mItems;
+    MatFileWriter mWriter;
+
+    std::vector<double> mBlock;
+};
+
+#endif // MATLABEXPORTER_H
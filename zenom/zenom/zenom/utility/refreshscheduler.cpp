@@ -0,0 +1,104 @@
+#include "refreshscheduler.h"
+
+#include <datarepository.h>
+
+/*
+ *  RefreshRate
+ */
+RefreshRate::RefreshRate( int pRate )
+    : mRate( 10 )
+    , mLast( -1 )
+{
+    setRate( pRate );
+}
+
+void RefreshRate::setRate( int pRate )
+{
+    mRate = qBound( 1, pRate, 60 );
+}
+
+int RefreshRate::rate() const
+{
+    return mRate;
+}
+
+bool RefreshRate::isDue( qint64 pNow )
+{
+    // The timer is not exact; a period that ends within half a frame is due.
+    const qint64 period = 1000 / mRate;
+    if ( mLast >= 0 && mLast <= pNow &&
+         pNow - mLast + RefreshScheduler::RUNNING_INTERVAL / 2 < period )
+        return false;
+
+    mLast = pNow;
+    return true;
+}
+
+/*
+ *  RefreshScheduler
+ */
+RefreshScheduler::RefreshScheduler( QObject* pParent )
+    : QObject( pParent )
+    , mHasChanges( false )
+{
+    mClock.start();
+    mTimer.setInterval( IDLE_INTERVAL );
+    connect( &mTimer, SIGNAL(timeout()), SLOT(timeout()) );
+}
+
+void RefreshScheduler::start()
+{
+    mSequences.clear();
+    mChanged.clear();
+    mTimer.start();
+}
+
+void RefreshScheduler::stop()
+{
+    mTimer.stop();
+    mSequences.clear();
+    mChanged.clear();
+    mHasChanges = false;
+}
+
+void RefreshScheduler::setRunning( bool pRunning )
+{
+    mTimer.setInterval( pRunning ? RUNNING_INTERVAL : IDLE_INTERVAL );
+}
+
+qint64 RefreshScheduler::now() const
+{
+    return mClock.elapsed();
+}
+
+bool RefreshScheduler::isChanged( LogVariable* pLogVariable ) const
+{
+    return mChanged.value( pLogVariable, false );
+}
+
+bool RefreshScheduler::hasChanges() const
+{
+    return mHasChanges;
+}
+
+void RefreshScheduler::timeout()
+{
+    // One read of the write sequence per variable and frame.
+    const std::vector<LogVariable*>& logVariables = DataRepository::instance()->logVariables();
+    mHasChanges = false;
+    for ( size_t i = 0; i < logVariables.size(); ++i )
+    {
+        LogVariable* logVariable = logVariables[i];
+        const uint64_t sequence = logVariable->isHeapValid() ? logVariable->writeSequence() : 0;
+
+        QHash<LogVariable*, uint64_t>::iterator it = mSequences.find( logVariable );
+        const bool changed = it == mSequences.end() || it.value() != sequence;
+        if ( changed )
+            mSequences[logVariable] = sequence;
+
+        mChanged[logVariable] = changed;
+        mHasChanges = mHasChanges || changed;
+    }
+
+    emit frame();
+}
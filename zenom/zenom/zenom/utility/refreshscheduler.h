@@ -0,0 +1,88 @@
+#ifndef REFRESHSCHEDULER_H
+#define REFRESHSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <logvariable.h>
+
+/**
+ * Bir pencerenin guncellenme hizi. Pencere her frame'de isDue() ile
+ * sirasinin gelip gelmedigine bakar.
+ */
+class RefreshRate
+{
+public:
+    explicit RefreshRate( int pRate = 10 );
+
+    /** Saniyedeki guncelleme sayisi, 1 - 60 araligina sinirlanir. */
+    void setRate( int pRate );
+
+    int rate() const;
+
+    /**
+     * Son guncellemeden bu yana bir periyot gecti ise true dondurur ve
+     * pNow'i son guncelleme olarak kaydeder.
+     * @param pNow RefreshScheduler::now() degeri
+     */
+    bool isDue( qint64 pNow );
+
+private:
+    int mRate;
+    qint64 mLast;
+};
+
+/**
+ * Arayuz pencerelerinin guncellenmesini zamanlar. Simulasyon calisirken
+ * 60 Hz, diger durumlarda 4 Hz frame uretir. Her frame'de log
+ * degiskenlerinin heap'e yazilan kayit sayisina bakarak hangilerinin
+ * degistigini belirler ve frame() sinyalini yayar.
+ *
+ * Pencereler kendi hizlarini RefreshRate ile secer ve girdileri
+ * degismedi ise cizim yapmaz; simulasyon duraklatildiginda frame'ler
+ * neredeyse is yapmaz.
+ */
+class RefreshScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    enum
+    {
+        RUNNING_INTERVAL = 16,  // ms
+        IDLE_INTERVAL = 250     // ms
+    };
+
+    explicit RefreshScheduler( QObject* pParent = 0 );
+
+    void start();
+
+    void stop();
+
+    /** Simulasyon calisiyor ise frame'ler hizlanir. */
+    void setRunning( bool pRunning );
+
+    /** start()'tan bu yana gecen sure (ms) */
+    qint64 now() const;
+
+    /** Log degiskeninin heap'i onceki frame'den bu yana buyudu ise true */
+    bool isChanged( LogVariable* pLogVariable ) const;
+
+    /** Herhangi bir log degiskeni onceki frame'den bu yana degisti ise true */
+    bool hasChanges() const;
+
+signals:
+    void frame();
+
+private slots:
+    void timeout();
+
+private:
+    QTimer mTimer;
+    QElapsedTimer mClock;
+    QHash<LogVariable*, uint64_t> mSequences;
+    QHash<LogVariable*, bool> mChanged;
+    bool mHasChanges;
+};
+
+#endif // REFRESHSCHEDULER_H
@@ -0,0 +1,152 @@
+#include "tickprofiler.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+
+/*
+ *  TickProfiler::Scope
+ */
+TickProfiler::Scope::Scope( const QString& pSection )
+    : mSection( pSection )
+{
+    mTimer.start();
+}
+
+TickProfiler::Scope::~Scope()
+{
+    if ( !mSection.isEmpty() )
+        TickProfiler::instance()->record( mSection, mTimer.nsecsElapsed() / 1e6 );
+}
+
+/*
+ *  TickProfiler
+ */
+TickProfiler* TickProfiler::instance()
+{
+    static TickProfiler profiler;
+    return &profiler;
+}
+
+TickProfiler::TickProfiler()
+{
+    mClock.start();
+}
+
+void TickProfiler::record( const QString& pSection, double pMsecs )
+{
+    QHash<QString, Section>::iterator it = mSections.find( pSection );
+    if ( it == mSections.end() )
+    {
+        Section section;
+        section.samples.reserve( WINDOW_SIZE );
+        section.next = 0;
+        it = mSections.insert( pSection, section );
+        mOrder.push_back( pSection );
+    }
+
+    Section& section = it.value();
+    if ( section.samples.size() < WINDOW_SIZE )
+    {
+        section.samples.push_back( pMsecs );
+    }
+    else
+    {
+        section.samples[section.next] = pMsecs;
+        section.next = (section.next + 1) % WINDOW_SIZE;
+    }
+    section.lastRecord = mClock.elapsed();
+}
+
+QStringList TickProfiler::sections() const
+{
+    // Kapatilan pencerelerin bolumleri bir sure sonra listelenmez.
+    const qint64 now = mClock.elapsed();
+    QStringList sections;
+    for ( int i = 0; i < mOrder.size(); ++i )
+    {
+        if ( now - mSections[mOrder[i]].lastRecord < IDLE_TIMEOUT )
+            sections.push_back( mOrder[i] );
+    }
+    return sections;
+}
+
+QVector<double> TickProfiler::window( const Section& pSection ) const
+{
+    QVector<double> samples;
+    samples.reserve( pSection.samples.size() );
+    for ( int i = pSection.next; i < pSection.samples.size(); ++i )
+        samples.push_back( pSection.samples[i] );
+    for ( int i = 0; i < pSection.next; ++i )
+        samples.push_back( pSection.samples[i] );
+    return samples;
+}
+
+TickProfiler::Percentiles TickProfiler::percentiles( const QString& pSection ) const
+{
+    Percentiles percentiles = { 0, 0, 0, 0, 0 };
+
+    QHash<QString, Section>::const_iterator it = mSections.constFind( pSection );
+    if ( it == mSections.constEnd() || it.value().samples.isEmpty() )
+        return percentiles;
+
+    QVector<double> samples = it.value().samples;
+    std::sort( samples.begin(), samples.end() );
+
+    const int n = samples.size();
+    percentiles.count = n;
+    percentiles.p50 = samples[ (n - 1) * 50 / 100 ];
+    percentiles.p95 = samples[ (n - 1) * 95 / 100 ];
+    percentiles.p99 = samples[ (n - 1) * 99 / 100 ];
+    percentiles.max = samples[ n - 1 ];
+    return percentiles;
+}
+
+QString TickProfiler::summary() const
+{
+    QStringList lines;
+    const QStringList names = sections();
+    for ( int i = 0; i < names.size(); ++i )
+    {
+        const Percentiles p = percentiles( names[i] );
+        lines.push_back( QString("%1: p50 %2  p95 %3  p99 %4  max %5 ms")
+                         .arg( names[i] )
+                         .arg( p.p50, 0, 'f', 2 ).arg( p.p95, 0, 'f', 2 )
+                         .arg( p.p99, 0, 'f', 2 ).arg( p.max, 0, 'f', 2 ) );
+    }
+    return lines.join( "\n" );
+}
+
+bool TickProfiler::dump( const QString& pFileName ) const
+{
+    QFile file( pFileName );
+    if ( !file.open(QIODevice::WriteOnly | QIODevice::Text) )
+        return false;
+
+    QTextStream out( &file );
+    out << "section,count,p50_ms,p95_ms,p99_ms,max_ms,samples_ms\n";
+    for ( int i = 0; i < mOrder.size(); ++i )
+    {
+        const Percentiles p = percentiles( mOrder[i] );
+
+        // Pencere basliklari virgul icerebilir.
+        QString name = mOrder[i];
+        name.replace( '"', "\"\"" );
+        out << '"' << name << '"' << ',' << p.count << ',' << p.p50 << ','
+            << p.p95 << ',' << p.p99 << ',' << p.max;
+
+        const QVector<double> samples = window( mSections[mOrder[i]] );
+        for ( int j = 0; j < samples.size(); ++j )
+            out << ',' << samples[j];
+        out << '\n';
+    }
+
+    out.flush();
+    return file.error() == QFile::NoError;
+}
+
+void TickProfiler::clear()
+{
+    mSections.clear();
+    mOrder.clear();
+}
@@ -0,0 +1,101 @@
+#ifndef TICKPROFILER_H
+#define TICKPROFILER_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QVector>
+#include <QElapsedTimer>
+
+/**
+ * Arayuz frame'lerinin hangi bolumde zaman harcadigini olcer. Her bolum
+ * (ornegin "plots" veya "plot Plot 1 paint") icin son WINDOW_SIZE
+ * olcumu saklar; yuzdelikler bu pencere uzerinden hesaplanir.
+ *
+ * Olcumler Scope ile alinir:
+ * @code
+ * {
+ *     TickProfiler::Scope scope( "gauges" );
+ *     mGaugeManager->tick( mRefreshScheduler );
+ * }
+ * @endcode
+ *
+ * Yalnizca GUI thread'inden kullanilir.
+ */
+class TickProfiler
+{
+public:
+    enum
+    {
+        WINDOW_SIZE = 600,      // 60 Hz'de son 10 s
+        IDLE_TIMEOUT = 10000    // ms, bu surede olcum almayan bolum listelenmez
+    };
+
+    /** Yuzdelikler ms cinsindendir. */
+    struct Percentiles
+    {
+        int count;
+        double p50;
+        double p95;
+        double p99;
+        double max;
+    };
+
+    /**
+     * Olusturuldugu andan yok edilene kadar gecen sureyi pSection'a ekler.
+     * pSection bos ise olcum alinmaz. Bolum isimleri her frame'de
+     * olusturulmamali, pencere basina bir kere hazirlanmalidir.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope( const QString& pSection );
+        ~Scope();
+
+    private:
+        QString mSection;
+        QElapsedTimer mTimer;
+    };
+
+    static TickProfiler* instance();
+
+    /** pSection'a pMsecs ms suren bir olcum ekler. */
+    void record( const QString& pSection, double pMsecs );
+
+    /** Son IDLE_TIMEOUT icinde olcum alan bolumler, ilk olcum sirasiyla */
+    QStringList sections() const;
+
+    Percentiles percentiles( const QString& pSection ) const;
+
+    /** Butun bolumlerin yuzdelikleri, satir basina bir bolum */
+    QString summary() const;
+
+    /**
+     * Her bolum icin bir satir yazar: isim, olcum sayisi, p50, p95, p99,
+     * max ve penceredeki olcumler (eskiden yeniye, ms), virgulle ayrilmis.
+     * @return dosya yazilamaz ise false
+     */
+    bool dump( const QString& pFileName ) const;
+
+    /** Butun olcumleri siler. */
+    void clear();
+
+private:
+    TickProfiler();
+
+    struct Section
+    {
+        QVector<double> samples;    // ring, mNext'ten itibaren en eski
+        int next;
+        qint64 lastRecord;
+    };
+
+    /** Penceredeki olcumler, eskiden yeniye */
+    QVector<double> window( const Section& pSection ) const;
+
+    QHash<QString, Section> mSections;
+    QStringList mOrder;
+    QElapsedTimer mClock;
+};
+
+#endif // TICKPROFILER_H
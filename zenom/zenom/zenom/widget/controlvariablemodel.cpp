@@ -0,0 +1,208 @@
+#include "controlvariablemodel.h"
+
+#include <QFont>
+
+ControlVariableModel::ControlVariableModel( QObject* pParent )
+    : QAbstractItemModel( pParent )
+    , mColumnCount( 2 )
+{
+
+}
+
+void ControlVariableModel::setControlVariableList( const ControlVariableList& pControlVariableList )
+{
+    beginResetModel();
+    mControlVariables = pControlVariableList;
+    mPending.clear();
+    mColumnCount = 2;
+    for ( size_t i = 0; i < mControlVariables.size(); ++i )
+    {
+        mColumnCount = qMax( mColumnCount, (int)mControlVariables[i]->col() + 1 );
+    }
+    endResetModel();
+
+    emit pendingValuesChanged( false );
+}
+
+void ControlVariableModel::applyValues()
+{
+    for ( QHash<qint64, double>::const_iterator it = mPending.constBegin(); it != mPending.constEnd(); ++it )
+    {
+        mControlVariables[ it.key() >> 32 ]->setHeapElement( (int)(it.key() & 0xFFFFFFFF), it.value() );
+    }
+    DataRepository::instance()->commitControlVariables();
+    mPending.clear();
+    refresh();
+
+    emit pendingValuesChanged( false );
+}
+
+void ControlVariableModel::discardValues()
+{
+    mPending.clear();
+    refresh();
+
+    emit pendingValuesChanged( false );
+}
+
+bool ControlVariableModel::hasPendingValues() const
+{
+    return !mPending.isEmpty();
+}
+
+void ControlVariableModel::refresh()
+{
+    // A range of cells repaints the viewport; only visible rows read the heap.
+    if ( !mControlVariables.empty() )
+        emit dataChanged( index(0, 0), index(mControlVariables.size() - 1, mColumnCount - 1) );
+}
+
+int ControlVariableModel::variableIndex( const QModelIndex& pIndex ) const
+{
+    const quintptr id = pIndex.internalId();
+    return id ? (int)id - 1 : pIndex.row();
+}
+
+int ControlVariableModel::matrixRow( const QModelIndex& pIndex ) const
+{
+    if ( pIndex.internalId() )
+        return pIndex.row();
+
+    return mControlVariables[ pIndex.row() ]->row() == 1 ? 0 : -1;
+}
+
+qint64 ControlVariableModel::elementKey( const QModelIndex& pIndex ) const
+{
+    if ( !pIndex.isValid() || pIndex.column() == 0 )
+        return -1;
+
+    const int index = variableIndex( pIndex );
+    ControlVariable* variable = mControlVariables[index];
+    const int row = matrixRow( pIndex );
+    const int col = pIndex.column() - 1;
+    if ( row < 0 || col >= (int)variable->col() )
+        return -1;
+
+    return ((qint64)index << 32) | (row * variable->col() + col);
+}
+
+QModelIndex ControlVariableModel::index( int pRow, int pColumn, const QModelIndex& pParent ) const
+{
+    if ( !hasIndex(pRow, pColumn, pParent) )
+        return QModelIndex();
+
+    if ( !pParent.isValid() )
+        return createIndex( pRow, pColumn );
+
+    return createIndex( pRow, pColumn, pParent.row() + 1 );
+}
+
+QModelIndex ControlVariableModel::parent( const QModelIndex& pChild ) const
+{
+    if ( !pChild.isValid() || !pChild.internalId() )
+        return QModelIndex();
+
+    return createIndex( (int)pChild.internalId() - 1, 0 );
+}
+
+int ControlVariableModel::rowCount( const QModelIndex& pParent ) const
+{
+    if ( !pParent.isValid() )
+        return mControlVariables.size();
+
+    if ( pParent.internalId() || pParent.column() != 0 )
+        return 0;
+
+    ControlVariable* variable = mControlVariables[ pParent.row() ];
+    return variable->row() == 1 ? 0 : variable->row();
+}
+
+int ControlVariableModel::columnCount( const QModelIndex& ) const
+{
+    return mColumnCount;
+}
+
+QVariant ControlVariableModel::data( const QModelIndex& pIndex, int pRole ) const
+{
+    if ( !pIndex.isValid() )
+        return QVariant();
+
+    ControlVariable* variable = mControlVariables[ variableIndex(pIndex) ];
+    if ( pIndex.column() == 0 )
+    {
+        if ( pRole != Qt::DisplayRole )
+            return QVariant();
+
+        const QString name = QString::fromStdString( variable->name() );
+        return pIndex.internalId() ? QString("%1[%2]").arg( name ).arg( pIndex.row() ) : name;
+    }
+
+    const qint64 key = elementKey( pIndex );
+    if ( key < 0 )
+        return QVariant();
+
+    QHash<qint64, double>::const_iterator pending = mPending.constFind( key );
+    switch ( pRole )
+    {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return QString::number( pending != mPending.constEnd() ? pending.value()
+                                    : variable->heapElement( (int)(key & 0xFFFFFFFF) ) );
+    case Qt::FontRole:
+        if ( pending != mPending.constEnd() )
+        {
+            QFont font;
+            font.setBold( true );
+            return font;
+        }
+        return QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+bool ControlVariableModel::setData( const QModelIndex& pIndex, const QVariant& pValue, int pRole )
+{
+    const qint64 key = elementKey( pIndex );
+    if ( key < 0 || pRole != Qt::EditRole )
+        return false;
+
+    // An invalid value is rejected and the heap value stays on screen.
+    bool ok;
+    const double value = pValue.toString().toDouble( &ok );
+    if ( !ok )
+        return false;
+
+    mPending[key] = value;
+    emit dataChanged( pIndex, pIndex );
+    emit pendingValuesChanged( true );
+    return true;
+}
+
+QVariant ControlVariableModel::headerData( int pSection, Qt::Orientation pOrientation, int pRole ) const
+{
+    if ( pOrientation != Qt::Horizontal || pRole != Qt::DisplayRole )
+        return QVariant();
+
+    if ( pSection == 0 )
+        return tr("Name");
+
+    if ( mColumnCount == 2 )
+        return tr("Value");
+
+    return QString("[%1]").arg( pSection - 1 );
+}
+
+Qt::ItemFlags ControlVariableModel::flags( const QModelIndex& pIndex ) const
+{
+    if ( !pIndex.isValid() )
+        return Qt::NoItemFlags;
+
+    if ( pIndex.column() == 0 )
+        return Qt::ItemIsEnabled;
+
+    if ( elementKey(pIndex) < 0 )
+        return Qt::NoItemFlags;
+
+    return Qt::ItemIsSelectable | Qt::ItemIsEditable | Qt::ItemIsEnabled;
+}
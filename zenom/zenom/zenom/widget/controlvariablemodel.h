@@ -0,0 +1,66 @@
+#ifndef CONTROLVARIABLEMODEL_H
+#define CONTROLVARIABLEMODEL_H
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <datarepository.h>
+
+/**
+ * Control variables and their values for a tree view. Column 0 holds the
+ * names, the values of a matrix row are in columns 1..col(). Scalars and
+ * row vectors show their values on their own row, the other variables
+ * have one child row per matrix row.
+ *
+ * Values are read from the heap when the view paints them. Edited values
+ * are kept as pending until applyValues() writes them to the heap or
+ * discardValues() drops them, so only edited elements are stored.
+ */
+class ControlVariableModel : public QAbstractItemModel
+{
+    Q_OBJECT
+public:
+    explicit ControlVariableModel( QObject* pParent = 0 );
+
+    void setControlVariableList( const ControlVariableList& pControlVariableList );
+
+    /** Writes the pending values to the heap. */
+    void applyValues();
+
+    /** Drops the pending values, the heap values are shown again. */
+    void discardValues();
+
+    bool hasPendingValues() const;
+
+    /** The heap was changed outside the model, values are repainted. */
+    void refresh();
+
+    QModelIndex index( int pRow, int pColumn, const QModelIndex& pParent = QModelIndex() ) const;
+    QModelIndex parent( const QModelIndex& pChild ) const;
+    int rowCount( const QModelIndex& pParent = QModelIndex() ) const;
+    int columnCount( const QModelIndex& pParent = QModelIndex() ) const;
+    QVariant data( const QModelIndex& pIndex, int pRole = Qt::DisplayRole ) const;
+    bool setData( const QModelIndex& pIndex, const QVariant& pValue, int pRole = Qt::EditRole );
+    QVariant headerData( int pSection, Qt::Orientation pOrientation, int pRole = Qt::DisplayRole ) const;
+    Qt::ItemFlags flags( const QModelIndex& pIndex ) const;
+
+signals:
+    /** A value is edited, or the pending values are applied or discarded. */
+    void pendingValuesChanged( bool pHasPendingValues );
+
+private:
+    // The internal id of a child row is the index of its variable + 1,
+    // top level rows have 0.
+    int variableIndex( const QModelIndex& pIndex ) const;
+
+    /** Matrix row of pIndex, -1 for the name only rows of matrices */
+    int matrixRow( const QModelIndex& pIndex ) const;
+
+    /** Key of the element at pIndex in mPending, -1 if it has no value */
+    qint64 elementKey( const QModelIndex& pIndex ) const;
+
+    ControlVariableList mControlVariables;
+    int mColumnCount;
+    QHash<qint64, double> mPending;
+};
+
+#endif // CONTROLVARIABLEMODEL_H
@@ -101,3 +101,23 @@ QPointF LogVariableItem::heapElement(int pIndex) const
 {
     return QPointF ( mLogVariable->heapElement(pIndex, mLogVariable->size()) , mLogVariable->heapElement(pIndex, mRow, mCol) );
 }
+
+QPointF LogVariableItem::heapElementBySequence(uint64_t pSequence) const
+{
+    return QPointF ( mLogVariable->heapTimeBySequence(pSequence),
+                     mLogVariable->heapElementBySequence(pSequence, mRow * mLogVariable->col() + mCol) );
+}
+
+void LogVariableItem::copyHeapSamples(uint64_t pFirstSequence, uint64_t pCount, QPointF* pDest) const
+{
+    // A QPointF is an (x, y) pair of doubles.
+    static_assert( sizeof(QPointF) == 2 * sizeof(double), "qreal must be double" );
+    mLogVariable->copyHeapSamples( pFirstSequence, pCount, mRow * mLogVariable->col() + mCol,
+                                   reinterpret_cast<double*>(pDest) );
+}
+
+void LogVariableItem::copyHeapSamples(uint64_t pFirstSequence, uint64_t pCount, QPolygonF& pSamples) const
+{
+    pSamples.resize( pCount );
+    copyHeapSamples( pFirstSequence, pCount, pSamples.data() );
+}
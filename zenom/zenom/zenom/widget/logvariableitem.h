@@ -4,6 +4,7 @@
 #include <logvariable.h>
 #include <QSettings>
 #include <QPointF>
+#include <QPolygonF>
 
 struct LogVariableItem
 {
@@ -21,6 +22,15 @@ public:
 	int column() const;
     int size() const;
     QPointF heapElement(int pIndex) const;
+    QPointF heapElementBySequence(uint64_t pSequence) const;
+
+    /**
+     * Copies the samples [pFirstSequence, pFirstSequence + pCount) to
+     * pDest in one strided pass over the heap. The range must be in
+     * [firstSequence, writeSequence) of the log variable.
+     */
+    void copyHeapSamples(uint64_t pFirstSequence, uint64_t pCount, QPointF* pDest) const;
+    void copyHeapSamples(uint64_t pFirstSequence, uint64_t pCount, QPolygonF& pSamples) const;
 
     bool isNull() const;
     bool isValid() const;
@@ -0,0 +1,128 @@
+#include "logvariablemodel.h"
+
+#include <algorithm>
+
+LogVariableModel::LogVariableModel( QObject* pParent )
+    : QAbstractItemModel( pParent )
+{
+
+}
+
+void LogVariableModel::setLogVariableList( const LogVariableList& pLogVariableList )
+{
+    beginResetModel();
+    mLogVariables = pLogVariableList;
+    endResetModel();
+}
+
+LogVariable* LogVariableModel::logVariable( const QModelIndex& pIndex ) const
+{
+    if ( !pIndex.isValid() )
+        return NULL;
+
+    const quintptr id = pIndex.internalId();
+    return mLogVariables[ id ? (int)id - 1 : pIndex.row() ];
+}
+
+LogVariableItem LogVariableModel::logVariableItem( const QModelIndex& pIndex ) const
+{
+    LogVariable* variable = logVariable( pIndex );
+    if ( !variable )
+        return LogVariableItem();
+
+    if ( pIndex.internalId() )
+        return LogVariableItem( variable, pIndex.row() / variable->col(), pIndex.row() % variable->col() );
+
+    // Only scalars are selected by their top level row.
+    if ( variable->size() > 1 )
+        return LogVariableItem();
+
+    return LogVariableItem( variable, 0, 0 );
+}
+
+QModelIndex LogVariableModel::indexOf( const LogVariableItem& pLogVariableItem ) const
+{
+    LogVariableList::const_iterator it =
+            std::find( mLogVariables.begin(), mLogVariables.end(), pLogVariableItem.logVariable() );
+    if ( pLogVariableItem.isNull() || it == mLogVariables.end() )
+        return QModelIndex();
+
+    const int row = it - mLogVariables.begin();
+    LogVariable* variable = *it;
+    if ( variable->size() == 1 )
+        return createIndex( row, 0 );
+
+    return createIndex( pLogVariableItem.row() * variable->col() + pLogVariableItem.column(), 0, row + 1 );
+}
+
+QModelIndex LogVariableModel::index( int pRow, int pColumn, const QModelIndex& pParent ) const
+{
+    if ( !hasIndex(pRow, pColumn, pParent) )
+        return QModelIndex();
+
+    if ( !pParent.isValid() )
+        return createIndex( pRow, pColumn );
+
+    return createIndex( pRow, pColumn, pParent.row() + 1 );
+}
+
+QModelIndex LogVariableModel::parent( const QModelIndex& pChild ) const
+{
+    if ( !pChild.isValid() || !pChild.internalId() )
+        return QModelIndex();
+
+    return createIndex( (int)pChild.internalId() - 1, 0 );
+}
+
+int LogVariableModel::rowCount( const QModelIndex& pParent ) const
+{
+    if ( !pParent.isValid() )
+        return mLogVariables.size();
+
+    if ( pParent.internalId() || pParent.column() != 0 )
+        return 0;
+
+    LogVariable* variable = mLogVariables[pParent.row()];
+    return variable->size() > 1 ? variable->size() : 0;
+}
+
+int LogVariableModel::columnCount( const QModelIndex& ) const
+{
+    return 1;
+}
+
+bool LogVariableModel::hasChildren( const QModelIndex& pParent ) const
+{
+    return rowCount( pParent ) > 0;
+}
+
+QVariant LogVariableModel::data( const QModelIndex& pIndex, int pRole ) const
+{
+    if ( pRole != Qt::DisplayRole || !pIndex.isValid() )
+        return QVariant();
+
+    if ( !pIndex.internalId() )
+        return QString::fromStdString( logVariable(pIndex)->name() );
+
+    return logVariableItem( pIndex ).name();
+}
+
+QVariant LogVariableModel::headerData( int pSection, Qt::Orientation pOrientation, int pRole ) const
+{
+    if ( pSection == 0 && pOrientation == Qt::Horizontal && pRole == Qt::DisplayRole )
+        return tr("Log Variables");
+
+    return QVariant();
+}
+
+Qt::ItemFlags LogVariableModel::flags( const QModelIndex& pIndex ) const
+{
+    if ( !pIndex.isValid() )
+        return Qt::NoItemFlags;
+
+    // Rows of vectors and matrices only group their elements.
+    if ( !pIndex.internalId() && logVariable(pIndex)->size() > 1 )
+        return Qt::ItemIsEnabled;
+
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
@@ -0,0 +1,46 @@
+#ifndef LOGVARIABLEMODEL_H
+#define LOGVARIABLEMODEL_H
+
+#include <QAbstractItemModel>
+#include <datarepository.h>
+#include "logvariableitem.h"
+
+/**
+ * Log variables as a two level tree: one top level row per variable and,
+ * for vectors and matrices, one child row per element. Nothing is stored
+ * per element; indexes and texts are computed when the view asks for
+ * them, so a 100x100 matrix costs as little as a scalar until it is
+ * expanded.
+ */
+class LogVariableModel : public QAbstractItemModel
+{
+    Q_OBJECT
+public:
+    explicit LogVariableModel( QObject* pParent = 0 );
+
+    void setLogVariableList( const LogVariableList& pLogVariableList );
+
+    /** The log variable item at pIndex, null for the rows of matrices */
+    LogVariableItem logVariableItem( const QModelIndex& pIndex ) const;
+
+    /** The row of pLogVariableItem, invalid if it is not in the model */
+    QModelIndex indexOf( const LogVariableItem& pLogVariableItem ) const;
+
+    QModelIndex index( int pRow, int pColumn, const QModelIndex& pParent = QModelIndex() ) const;
+    QModelIndex parent( const QModelIndex& pChild ) const;
+    int rowCount( const QModelIndex& pParent = QModelIndex() ) const;
+    int columnCount( const QModelIndex& pParent = QModelIndex() ) const;
+    bool hasChildren( const QModelIndex& pParent = QModelIndex() ) const;
+    QVariant data( const QModelIndex& pIndex, int pRole = Qt::DisplayRole ) const;
+    QVariant headerData( int pSection, Qt::Orientation pOrientation, int pRole = Qt::DisplayRole ) const;
+    Qt::ItemFlags flags( const QModelIndex& pIndex ) const;
+
+private:
+    // The internal id of a child row is the index of its variable + 1,
+    // top level rows have 0.
+    LogVariable* logVariable( const QModelIndex& pIndex ) const;
+
+    LogVariableList mLogVariables;
+};
+
+#endif // LOGVARIABLEMODEL_H
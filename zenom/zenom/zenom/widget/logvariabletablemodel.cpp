@@ -0,0 +1,158 @@
+#include "logvariabletablemodel.h"
+
+#include <QFont>
+#include <QBrush>
+
+LogVariableTableModel::LogVariableTableModel( QObject* pParent )
+    : QAbstractTableModel( pParent )
+{
+
+}
+
+void LogVariableTableModel::setLogVariableList( const LogVariableList& pLogVariableList )
+{
+    beginResetModel();
+    mLogVariables = pLogVariableList;
+    mCustomized.fill( false, mLogVariables.size() );
+    endResetModel();
+}
+
+bool LogVariableTableModel::isCustomized( int pRow ) const
+{
+    return mCustomized[pRow];
+}
+
+void LogVariableTableModel::setCustomized( int pRow, bool pCustomized )
+{
+    if ( mCustomized[pRow] != pCustomized )
+    {
+        mCustomized[pRow] = pCustomized;
+        updateRow( pRow );
+    }
+}
+
+void LogVariableTableModel::updateRow( int pRow )
+{
+    emit dataChanged( index(pRow, 0), index(pRow, COLUMN_COUNT - 1) );
+}
+
+void LogVariableTableModel::updateRows()
+{
+    if ( !mLogVariables.empty() )
+        emit dataChanged( index(0, 0), index(mLogVariables.size() - 1, COLUMN_COUNT - 1) );
+}
+
+int LogVariableTableModel::rowCount( const QModelIndex& pParent ) const
+{
+    return pParent.isValid() ? 0 : mLogVariables.size();
+}
+
+int LogVariableTableModel::columnCount( const QModelIndex& pParent ) const
+{
+    return pParent.isValid() ? 0 : COLUMN_COUNT;
+}
+
+QVariant LogVariableTableModel::data( const QModelIndex& pIndex, int pRole ) const
+{
+    if ( !pIndex.isValid() )
+        return QVariant();
+
+    LogVariable* logVariable = mLogVariables[ pIndex.row() ];
+    switch ( pRole )
+    {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        switch ( pIndex.column() )
+        {
+        case NAME:
+            return QString::fromStdString( logVariable->name() );
+        case FREQUENCY:
+            return QString::number( logVariable->frequency() );
+        case START_TIME:
+            return QString::number( logVariable->startTime() );
+        case DURATION:
+            return QString::number( logVariable->duration() );
+        }
+        break;
+
+    case Qt::FontRole:
+        if ( mCustomized[ pIndex.row() ] )
+        {
+            QFont font;
+            font.setBold( true );
+            return font;
+        }
+        break;
+
+    case Qt::ToolTipRole:
+        if ( pIndex.column() == NAME && logVariable->trigger().isEnabled() )
+        {
+            const LogTrigger& trigger = logVariable->trigger();
+            LogVariable* source = mLogVariables[trigger.source];
+            return tr("Triggered by %1, %2 samples before and %3 after")
+                    .arg( QString::fromStdString(source->name()) )
+                    .arg( trigger.preTrigger ).arg( trigger.postTrigger );
+        }
+        break;
+
+    case Qt::ForegroundRole:
+        if ( pIndex.column() == NAME && logVariable->trigger().isEnabled() )
+            return QBrush( Qt::darkRed );
+        break;
+    }
+
+    return QVariant();
+}
+
+bool LogVariableTableModel::setData( const QModelIndex& pIndex, const QVariant& pValue, int pRole )
+{
+    if ( !pIndex.isValid() || pRole != Qt::EditRole )
+        return false;
+
+    // Invalid values are rejected, the current setting stays on screen.
+    bool ok;
+    const double value = pValue.toString().toDouble( &ok );
+    LogVariable* logVariable = mLogVariables[ pIndex.row() ];
+    if ( pIndex.column() == FREQUENCY && ok && value > 0 )
+        logVariable->setFrequency( value );
+    else if ( pIndex.column() == START_TIME && ok && value >= 0 )
+        logVariable->setStartTime( value );
+    else if ( pIndex.column() == DURATION && ok && value > 0 )
+        logVariable->setDuration( value );
+    else
+        return false;
+
+    emit dataChanged( pIndex, pIndex );
+    return true;
+}
+
+QVariant LogVariableTableModel::headerData( int pSection, Qt::Orientation pOrientation, int pRole ) const
+{
+    if ( pOrientation != Qt::Horizontal || pRole != Qt::DisplayRole )
+        return QAbstractTableModel::headerData( pSection, pOrientation, pRole );
+
+    switch ( pSection )
+    {
+    case NAME:
+        return tr("Name");
+    case FREQUENCY:
+        return tr("Freq (Hz)");
+    case START_TIME:
+        return tr("Start Time (s)");
+    case DURATION:
+        return tr("Duration (s)");
+    }
+
+    return QVariant();
+}
+
+Qt::ItemFlags LogVariableTableModel::flags( const QModelIndex& pIndex ) const
+{
+    if ( !pIndex.isValid() || !mCustomized[ pIndex.row() ] )
+        return Qt::NoItemFlags;
+
+    if ( pIndex.column() == NAME )
+        return Qt::ItemIsEnabled;
+
+    return Qt::ItemIsEditable | Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
@@ -0,0 +1,52 @@
+#ifndef LOGVARIABLETABLEMODEL_H
+#define LOGVARIABLETABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <datarepository.h>
+
+/**
+ * Logging settings of the log variables, one row per variable: name,
+ * frequency, start time and duration. The values are read from the log
+ * variables when the view paints them. Only customized variables can be
+ * edited; their rows are bold.
+ */
+class LogVariableTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column
+    {
+        NAME,
+        FREQUENCY,
+        START_TIME,
+        DURATION,
+        COLUMN_COUNT
+    };
+
+    explicit LogVariableTableModel( QObject* pParent = 0 );
+
+    void setLogVariableList( const LogVariableList& pLogVariableList );
+
+    bool isCustomized( int pRow ) const;
+    void setCustomized( int pRow, bool pCustomized );
+
+    /** The settings of the variable at pRow changed outside the model. */
+    void updateRow( int pRow );
+
+    /** The settings of all variables changed outside the model. */
+    void updateRows();
+
+    int rowCount( const QModelIndex& pParent = QModelIndex() ) const;
+    int columnCount( const QModelIndex& pParent = QModelIndex() ) const;
+    QVariant data( const QModelIndex& pIndex, int pRole = Qt::DisplayRole ) const;
+    bool setData( const QModelIndex& pIndex, const QVariant& pValue, int pRole = Qt::EditRole );
+    QVariant headerData( int pSection, Qt::Orientation pOrientation, int pRole = Qt::DisplayRole ) const;
+    Qt::ItemFlags flags( const QModelIndex& pIndex ) const;
+
+private:
+    LogVariableList mLogVariables;
+    QVector<bool> mCustomized;
+};
+
+#endif // LOGVARIABLETABLEMODEL_H
@@ -1,11 +1,16 @@
 #ifndef LOGVARIABLETREEWIDGET_H
 #define LOGVARIABLETREEWIDGET_H
 
-#include <QTreeWidget>
+#include <QTreeView>
 #include <datarepository.h>
 #include "logvariableitem.h"
+#include "logvariablemodel.h"
 
-class LogVariableTreeWidget : public QTreeWidget
+/*
+Tree of log variables and their elements on a LogVariableModel. Element
+rows are created only when a variable is expanded.
+*/
+class LogVariableTreeWidget : public QTreeView
 {
 	Q_OBJECT
 
@@ -32,7 +37,7 @@ public:
 	void setCurrentLogVariableItem( LogVariableItem pLogVariableItem );
 
 private:
-	
+	LogVariableModel* mModel;
 };
 
 #endif // LOGVARIABLETREEWIDGET_H
@@ -0,0 +1,72 @@
+#include "runningstatistics.h"
+#include <cmath>
+
+RunningStatistics::RunningStatistics()
+{
+    clear();
+}
+
+void RunningStatistics::clear()
+{
+    mCount = 0;
+    mMin = 0;
+    mMax = 0;
+    mMean = 0;
+    mMeanSquare = 0;
+}
+
+void RunningStatistics::add( double pValue )
+{
+    ++mCount;
+    if ( mCount == 1 )
+    {
+        mMin = pValue;
+        mMax = pValue;
+    }
+    else if ( pValue < mMin )
+    {
+        mMin = pValue;
+    }
+    else if ( pValue > mMax )
+    {
+        mMax = pValue;
+    }
+
+    // Running means do not grow like plain sums on long runs.
+    mMean += (pValue - mMean) / mCount;
+    mMeanSquare += (pValue * pValue - mMeanSquare) / mCount;
+}
+
+uint64_t RunningStatistics::count() const
+{
+    return mCount;
+}
+
+double RunningStatistics::min() const
+{
+    return mMin;
+}
+
+double RunningStatistics::max() const
+{
+    return mMax;
+}
+
+double RunningStatistics::mean() const
+{
+    return mMean;
+}
+
+double RunningStatistics::rms() const
+{
+    return std::sqrt( mMeanSquare );
+}
+
+QString RunningStatistics::toString() const
+{
+    if ( mCount == 0 )
+        return QString();
+
+    return QString("min %1  max %2  mean %3  rms %4")
+            .arg( mMin ).arg( mMax ).arg( mMean ).arg( rms() );
+}
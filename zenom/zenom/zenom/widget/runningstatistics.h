@@ -0,0 +1,42 @@
+#ifndef RUNNINGSTATISTICS_H
+#define RUNNINGSTATISTICS_H
+
+#include <QString>
+#include <cstdint>
+
+/**
+ * Minimum, maximum, mean and RMS of a stream of values. Values are added
+ * one at a time as the log heap grows, so the cost of a tick does not
+ * depend on how long the run is.
+ */
+class RunningStatistics
+{
+public:
+    RunningStatistics();
+
+    void clear();
+
+    void add( double pValue );
+
+    uint64_t count() const;
+
+    double min() const;
+
+    double max() const;
+
+    double mean() const;
+
+    double rms() const;
+
+    /** Single line summary, e.g. for a tool tip */
+    QString toString() const;
+
+private:
+    uint64_t mCount;
+    double mMin;
+    double mMax;
+    double mMean;           // updated with Welford's method
+    double mMeanSquare;
+};
+
+#endif // RUNNINGSTATISTICS_H
@@ -29,3 +29,20 @@ void StatusBar::setElapsedTime(const double pElapsedTime)
     ui->progressBar->setValue( qRound(pElapsedTime) );
     ui->elapsedTime->setText( QString("T=%1").arg( QString::number(pElapsedTime, 'f', 3) ) );
 }
+
+void StatusBar::setLogStream(bool pStreaming, const double pLag, const double pDropped)
+{
+    ui->line_4->setVisible( pStreaming );
+    ui->logStream->setVisible( pStreaming );
+    ui->logStream->setText( QString("L=%1 D=%2")
+                            .arg( QString::number(pLag, 'f', 2) )
+                            .arg( pDropped ) );
+}
+
+void StatusBar::setGuiLoad(const double pFrameP95, const double pFrameMax, const QString& pDetails)
+{
+    ui->guiLoad->setText( QString("G=%1/%2")
+                          .arg( QString::number(pFrameP95, 'f', 1) )
+                          .arg( QString::number(pFrameMax, 'f', 1) ) );
+    ui->guiLoad->setToolTip( tr("GUI tick time p95/max in ms\n\n%1").arg( pDetails ) );
+}
@@ -21,6 +21,19 @@ public:
     void setOverruns( const double pOverruns );
 
     void setElapsedTime( const double pElapsedTime );
+
+    /**
+     * Shows how far the log streamer is behind and how many records it
+     * dropped. Hidden when log streaming is off.
+     */
+    void setLogStream( bool pStreaming, const double pLag, const double pDropped );
+
+    /**
+     * Shows the 95th percentile and the maximum of the time a GUI frame
+     * spends in ticks, in ms. pDetails, the timings of every section
+     * including window paints, is the tool tip.
+     */
+    void setGuiLoad( const double pFrameP95, const double pFrameMax, const QString& pDetails );
     
 private:
     Ui::StatusBar *ui;
@@ -14,7 +14,7 @@
 
 
 
-#include "utility/matlabstream.h"
+#include "utility/matlabexporter.h"
 
 Zenom::Zenom(int argc, char *argv[]) :
     QMainWindow( NULL ),
@@ -34,6 +34,8 @@ Zenom::Zenom(int argc, char *argv[]) :
 
     mLogVariablesWidget = new LogVariablesWidget(this);
     ui->menu_View->addAction( mLogVariablesWidget->toggleViewAction() );
+    ui->menu_View->addSeparator();
+    ui->menu_View->addAction( tr("Save GUI Timings..."), this, SLOT(saveGuiTimings()) );
 
     mGaugeManager = new GaugeManager(this);
     mPlotManager = new PlotManager(this);
@@ -57,7 +59,7 @@ Zenom::Zenom(int argc, char *argv[]) :
 
     setSimulationState( TERMINATED );
 
-    connect(&mTimer, SIGNAL(timeout()), SLOT(doloop()));
+    connect(&mRefreshScheduler, SIGNAL(frame()), SLOT(doloop()));
 
     mAboutDialog = new AboutDialog(this);
 
@@ -183,13 +185,67 @@ void Zenom::controlBaseReadyReadStandardError()
 
 void Zenom::doloop()
 {
-    mStatusBar->setElapsedTime( mDataRepository->elapsedTimeSecond() );
-    mStatusBar->setOverruns( mDataRepository->overruns() );
-    mGaugeManager->tick();
-    mPlotManager->tick();
-    mSceneManager->tick();
-    mCameraManager->tick();
-    mTargetUI->tick();
+    TickProfiler::Scope frameScope( "frame" );
+
+    // Control variable changes wait while the loop reads their buffer in place.
+    mDataRepository->commitControlVariables();
+
+    if ( mStatusRefreshRate.isDue( mRefreshScheduler.now() ) )
+    {
+        {
+            TickProfiler::Scope scope( "status" );
+            TickProfiler* profiler = TickProfiler::instance();
+            const TickProfiler::Percentiles frame = profiler->percentiles( "frame" );
+            mStatusBar->setElapsedTime( mDataRepository->elapsedTimeSecond() );
+            mStatusBar->setOverruns( mDataRepository->overruns() );
+            mStatusBar->setLogStream( mDataRepository->logStreaming(),
+                                      mDataRepository->logStreamLag(),
+                                      mDataRepository->logStreamDropped() );
+            mStatusBar->setGuiLoad( frame.p95, frame.max, profiler->summary() );
+        }
+
+        TickProfiler::Scope scope( "target" );
+        mTargetUI->tick();
+    }
+
+    // Windows skip the frame unless they are due and their data changed.
+    {
+        TickProfiler::Scope scope( "gauges" );
+        mGaugeManager->tick( mRefreshScheduler );
+    }
+    {
+        TickProfiler::Scope scope( "plots" );
+        mPlotManager->tick( mRefreshScheduler );
+    }
+    {
+        TickProfiler::Scope scope( "scenes" );
+        mSceneManager->tick( mRefreshScheduler );
+    }
+    {
+        TickProfiler::Scope scope( "camera" );
+        mCameraManager->tick();
+    }
+}
+
+void Zenom::saveGuiTimings()
+{
+    QString fileName = QFileDialog::getSaveFileName( this,
+                                                     tr("GUI Timings File Name"),
+                                                     QString(),
+                                                     "CSV (*.csv)",
+                                                     NULL,
+                                                     QFileDialog::DontUseNativeDialog);
+
+    if ( !fileName.isEmpty() )
+    {
+        if ( !fileName.endsWith(".csv") )
+            fileName += ".csv";
+
+        if ( !TickProfiler::instance()->dump(fileName) )
+        {
+            ui->output->appendErrorMessage( QString("Error: Failed saving GUI timings to '%1'.").arg(fileName) );
+        }
+    }
 }
 
 State Zenom::simulationState()
@@ -200,6 +256,7 @@ State Zenom::simulationState()
 void Zenom::setSimulationState(State pState)
 {
     mSimState = pState;
+    mRefreshScheduler.setRunning( pState == RUNNING );
 
     // File Menu
     ui->actionSave_Project->setEnabled( pState != TERMINATED );
@@ -285,7 +342,7 @@ void Zenom::openProject(const QString& pProjectPath)
                 return;
             }
 
-            if( !mDataRepository->readVariablesFromFile() )
+            if( !mDataRepository->readSchema() )
             {
                 ui->output->appendErrorMessage(
                             QString("Error2: Failed connecting program: The program"
@@ -319,7 +376,7 @@ void Zenom::openProject(const QString& pProjectPath)
             loadSettings( projectAbsolutePath );
 
 
-            mTimer.start(100);
+            mRefreshScheduler.start();
 
             setWindowTitle( fileInfo.baseName() );
 
@@ -349,6 +406,10 @@ void Zenom::loadSettings(const QString &pProjectName)
     settings.beginGroup("zenom");
     setFrequency( settings.value("frequency", 1).toDouble() );
     setDuration( settings.value("duration", 100).toDouble() );
+    mDataRepository->setLogRingCapacity( settings.value("logRingCapacity", 0).toUInt() );
+    mDataRepository->setFrameLogging( settings.value("frameLogging", true).toBool() );
+    mDataRepository->setLogStreaming( settings.value("logStreaming", false).toBool() );
+    mDataRepository->setLogCompression( settings.value("logCompression", false).toBool() );
     restoreGeometry( settings.value("geometry").toByteArray() );
     mLogVariablesWidget->loadSettings( settings );      // log variable values
     mControlVariablesWidget->loadSettings( settings );	// control variable values
@@ -371,6 +432,10 @@ void Zenom::on_actionSave_Project_triggered()
     settings.beginGroup("zenom");
     settings.setValue("frequency", ui->frequency->text());
     settings.setValue("duration", ui->duration->text());
+    settings.setValue("logRingCapacity", mDataRepository->logRingCapacity());
+    settings.setValue("frameLogging", mDataRepository->frameLogging());
+    settings.setValue("logStreaming", mDataRepository->logStreaming());
+    settings.setValue("logCompression", mDataRepository->logCompression());
     settings.setValue("geometry", saveGeometry());
     mLogVariablesWidget->saveSettings( settings );      // log variable values
     mControlVariablesWidget->saveSettings( settings );  // control variable values
@@ -473,7 +538,7 @@ void Zenom::terminateProject()
     if(mMessageListenerTask != nullptr)
         delete mMessageListenerTask;
 
-    mTimer.stop();
+    mRefreshScheduler.stop();
 
     mDataRepository->deleteMessageQueues();
     std::cerr << "deleted message queues" << std::endl;
@@ -568,24 +633,28 @@ void Zenom::on_actionExport_as_Matlab_triggered()
     QString fileName = QFileDialog::getSaveFileName( this,
                                                      tr("Export File Name"),
                                                      QString(),
-                                                     "Matlab (*.m)",
+                                                     "Matlab (*.mat)",
                                                      NULL,
                                                      QFileDialog::DontUseNativeDialog);
 
     if ( !fileName.isEmpty() )
     {
-        if ( !fileName.endsWith(".m") )
-            fileName += ".m";
-
-        QFile file( fileName );
-        if (!file.open(QIODevice::WriteOnly))
-            return;
+        if ( !fileName.endsWith(".mat") )
+            fileName += ".mat";
 
         // Log variable listesi dosyaya yazilir.
-        MatlabStream out(&file);
+        MatlabExporter exporter( fileName );
         for ( unsigned int i = 0; i < DataRepository::instance()->logVariables().size(); ++i )
         {
-            out.writeLogVariable( DataRepository::instance()->logVariables().at(i) );
+            exporter.addLogVariable( DataRepository::instance()->logVariables().at(i) );
+        }
+
+        if ( !exporter.exec(this) )
+        {
+            if ( exporter.isCanceled() )
+                ui->output->appendWarningMessage( QString("Export to '%1' canceled.").arg(fileName) );
+            else
+                ui->output->appendErrorMessage( QString("Error: Failed exporting to '%1'.").arg(fileName) );
         }
     }
 }
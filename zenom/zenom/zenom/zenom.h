@@ -27,6 +27,8 @@
 #include "camerascene.h"
 #include "robotmodedialog.h"
 #include "target/targetui.h"
+#include "utility/refreshscheduler.h"
+#include "utility/tickprofiler.h"
 
 #include <fstream>
 
@@ -133,6 +135,12 @@ private slots:
      */
     void doloop();
 
+    /**
+     * Arayuz frame'lerinin bolum bolum olculen surelerini bir CSV
+     * dosyasina yazar.
+     */
+    void saveGuiTimings();
+
     /**
      * Control-Base process'te bir hata olustugunda cagrilir.
      * @param pError hata kodu
@@ -284,10 +292,13 @@ private:
     void setDuration(double pDuration);
 
     /**
-     * Arayuzlerin guncellenmesini saglayan doloop fonksiyonunu
-     * periyodik olarak cagrilmasini saglayan nesnedir.
+     * Arayuzlerin guncellenmesini saglayan doloop fonksiyonunu her
+     * frame'de cagiran nesnedir.
      */
-    QTimer mTimer;
+    RefreshScheduler mRefreshScheduler;
+
+    /** Durum cubugu ve target arayuzunun guncellenme hizi */
+    RefreshRate mStatusRefreshRate;
 
     // the most recent files loaded by user.
     void createRecentFileActions();
@@ -37,9 +37,14 @@ SOURCES += main.cpp\
 	widget/statusbar.cpp \
 	widget/checkedheader.cpp \
 	widget/logvariabletreewidget.cpp \
+	widget/logvariablemodel.cpp \
+	widget/logvariabletablemodel.cpp \
+	widget/controlvariablemodel.cpp \
 	widget/logvariableitem.cpp \
+	widget/runningstatistics.cpp \
 	gauge/radialgaugesettingwidget.cpp \
 	gauge/radialgauge.cpp \
+	gauge/staticlayer.cpp \
 	gauge/numericgaugesettingwidget.cpp \
 	gauge/numericgauge.cpp \
 	gauge/lineargaugesettingwidget.cpp \
@@ -71,12 +76,20 @@ SOURCES += main.cpp\
 	plot/legenditem.cpp \
 	plot/plot.cpp \
 	plot/plotmagnifier.cpp \
+	plot/minmaxpyramid.cpp \
+	plot/plotrenderer.cpp \
 	widget/output.cpp \
 	aboutdialog.cpp \
-	utility/matlabstream.cpp \
+	utility/exporter.cpp \
+	utility/binaryexporter.cpp \
+	utility/matfilewriter.cpp \
+	utility/matlabexporter.cpp \
+	utility/refreshscheduler.cpp \
+	utility/tickprofiler.cpp \
 	widget/linesizecombobox.cpp \
 	camerascene.cpp \
 	robotmodedialog.cpp \
+	logtriggerdialog.cpp \
 	target/comboboxitemdelegate.cpp \
 	target/targettask.cpp
 
@@ -93,9 +106,14 @@ HEADERS  += zenom.h \
 	widget/statusbar.h \
 	widget/checkedheader.h \
 	widget/logvariabletreewidget.h \
+	widget/logvariablemodel.h \
+	widget/logvariabletablemodel.h \
+	widget/controlvariablemodel.h \
 	widget/logvariableitem.h \
+	widget/runningstatistics.h \
 	gauge/radialgaugesettingwidget.h \
 	gauge/radialgauge.h \
+	gauge/staticlayer.h \
 	gauge/numericgaugesettingwidget.h \
 	gauge/numericgauge.h \
 	gauge/lineargaugesettingwidget.h \
@@ -127,12 +145,20 @@ HEADERS  += zenom.h \
 	plot/legenditem.h \
 	plot/plot.h \
 	plot/plotmagnifier.h \
+	plot/minmaxpyramid.h \
+	plot/plotrenderer.h \
 	widget/output.h \
 	aboutdialog.h \
-	utility/matlabstream.h \
+	utility/exporter.h \
+	utility/binaryexporter.h \
+	utility/matfilewriter.h \
+	utility/matlabexporter.h \
+	utility/refreshscheduler.h \
+	utility/tickprofiler.h \
 	widget/linesizecombobox.h \
 	camerascene.h \
 	robotmodedialog.h \
+	logtriggerdialog.h \
 	target/comboboxitemdelegate.h \
 	target/targettask.h
 
@@ -155,7 +181,8 @@ FORMS    += zenom.ui \
 	plot/legenditem.ui \
 	aboutdialog.ui \
 	camerascene.ui \
-	robotmodedialog.ui
+	robotmodedialog.ui \
+	logtriggerdialog.ui
 
 RESOURCES += \
 	zenom.qrc
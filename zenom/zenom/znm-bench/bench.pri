@@ -0,0 +1,30 @@
+#--------------------------------------------------------------
+#
+# Zenom Hard Real-Time Simulation Enviroment
+# Copyright (C) 2013
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the Zenom License, Version 1.0
+#
+#--------------------------------------------------------------
+
+include( ../../zenom.pri )
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= qt
+QMAKE_CXXFLAGS += -std=c++11
+CONFIG += c++11
+
+# Zenom Core Library
+INCLUDEPATH += ../../znm-core
+DEPENDPATH += ../../znm-core
+
+# Zenom Tools Library
+INCLUDEPATH += ../../znm-tools
+DEPENDPATH += ../../znm-tools
+
+LIBS += -L../../../lib -lrt -lznm-core -lznm-tools
+
+# build directory, benchmarks are not installed
+DESTDIR = ../../../bin
@@ -0,0 +1,38 @@
+#--------------------------------------------------------------
+#
+# Zenom Hard Real-Time Simulation Enviroment
+# Copyright (C) 2013
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the Zenom License, Version 1.0
+#
+#--------------------------------------------------------------
+
+include( ../bench.pri )
+
+CONFIG += qt qwt
+QT += core gui
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = gaugepaintbench
+
+# Gauge sources of the GUI, built into the benchmark
+ZENOM_GUI = ../../zenom
+INCLUDEPATH += $${ZENOM_GUI}
+DEPENDPATH += $${ZENOM_GUI}
+
+SOURCES += main.cpp \
+	$${ZENOM_GUI}/gauge/radialgauge.cpp \
+	$${ZENOM_GUI}/gauge/lineargauge.cpp \
+	$${ZENOM_GUI}/gauge/abstractgauge.cpp \
+	$${ZENOM_GUI}/gauge/staticlayer.cpp \
+	$${ZENOM_GUI}/widget/runningstatistics.cpp
+
+HEADERS += \
+	$${ZENOM_GUI}/gauge/radialgauge.h \
+	$${ZENOM_GUI}/gauge/lineargauge.h
+
+# Qwt
+INCLUDEPATH +=  $${QWT_HEADERS}
+DEPENDPATH += $${QWT_HEADERS}
+LIBS += -L$${QWT_LIBS} -lqwt
@@ -0,0 +1,88 @@
+/*
+ * gaugepaintbench
+ *
+ *  Paint time of the radial and linear gauges. Each gauge is shown and
+ *  repainted with a new value a number of times, once as it is in zenom,
+ *  blitting its StaticLayer, and once through the paint event of its Qwt
+ *  base class, which draws the face, scale and labels on every paint as
+ *  before the layer was added.
+ *
+ *  usage: gaugepaintbench [repaints] [size]
+ *  Without a display run it with -platform offscreen (Qt 5) or under Xvfb.
+ */
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cstdlib>
+#include "gauge/radialgauge.h"
+#include "gauge/lineargauge.h"
+
+/** RadialGauge painting its face every time */
+class UncachedRadialGauge : public RadialGauge
+{
+protected:
+    virtual void paintEvent( QPaintEvent* pEvent )
+    {
+        QwtDial::paintEvent( pEvent );
+    }
+};
+
+/** LinearGauge painting its scale and frame every time */
+class UncachedLinearGauge : public LinearGauge
+{
+protected:
+    virtual void paintEvent( QPaintEvent* pEvent )
+    {
+        QwtThermo::paintEvent( pEvent );
+    }
+};
+
+/** Mean paint time in microseconds, the first paint is left out */
+template <class Gauge>
+static double paintTime( Gauge* pGauge, int pRepaints, int pSize )
+{
+    pGauge->resize( pSize, pSize );
+    pGauge->show();
+    QApplication::processEvents();
+    pGauge->repaint();
+
+    // The value sweeps the range so the needle or pipe moves each time.
+    const double step = (pGauge->maxValue() - pGauge->minValue()) / 100;
+    QElapsedTimer timer;
+    timer.start();
+    for ( int i = 0; i < pRepaints; ++i )
+    {
+        pGauge->setValue( pGauge->minValue() + (i % 100) * step );
+        pGauge->repaint();
+    }
+    const double elapsed = timer.nsecsElapsed() / 1e3;
+
+    pGauge->hide();
+    return elapsed / pRepaints;
+}
+
+int main( int argc, char* argv[] )
+{
+    QApplication application( argc, argv );
+    const QStringList arguments = application.arguments();
+    const int repaints = arguments.size() > 1 ? arguments[1].toInt() : 1000;
+    const int size = arguments.size() > 2 ? arguments[2].toInt() : 300;
+
+    RadialGauge radial;
+    UncachedRadialGauge uncachedRadial;
+    LinearGauge linear;
+    UncachedLinearGauge uncachedLinear;
+
+    const double radialTime = paintTime( &radial, repaints, size );
+    const double uncachedRadialTime = paintTime( &uncachedRadial, repaints, size );
+    const double linearTime = paintTime( &linear, repaints, size );
+    const double uncachedLinearTime = paintTime( &uncachedLinear, repaints, size );
+
+    printf( "%d repaints of %dx%d gauges, mean paint time\n", repaints, size, size );
+    printf( "  radial: %.1f us cached, %.1f us uncached, x%.1f\n",
+            radialTime, uncachedRadialTime, uncachedRadialTime / radialTime );
+    printf( "  linear: %.1f us cached, %.1f us uncached, x%.1f\n",
+            linearTime, uncachedLinearTime, uncachedLinearTime / linearTime );
+    return 0;
+}
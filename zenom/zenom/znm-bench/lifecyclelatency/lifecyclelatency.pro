@@ -0,0 +1,19 @@
+#--------------------------------------------------------------
+#
+# Zenom Hard Real-Time Simulation Enviroment
+# Copyright (C) 2013
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the Zenom License, Version 1.0
+#
+#--------------------------------------------------------------
+
+# ControlBase, linked before the libraries it depends on
+INCLUDEPATH += ../../znm-controlbase
+DEPENDPATH += ../../znm-controlbase
+LIBS += -lznm-controlbase
+
+include( ../bench.pri )
+
+TARGET = lifecyclelatency
+SOURCES += main.cpp
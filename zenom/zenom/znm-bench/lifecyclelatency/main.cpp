@@ -0,0 +1,256 @@
+/*
+ * lifecyclelatency
+ *
+ *  Round-trip latency of the lifecycle commands. As in logstreambench the
+ *  same binary is both sides: run without a project name it plays the GUI
+ *  and starts itself as the control program over the real message queues.
+ *  Each round opens the program, starts, pauses, resumes and stops the
+ *  loop at 10 kHz and terminates it.
+ *
+ *  The control program stamps the time it acts on a command into a small
+ *  shared memory probe; both processes read the same monotonic clock.
+ *    init       fork until the second R_INIT of the handshake
+ *    start      R_START until the first doloop()
+ *    pause      R_PAUSE until the last doloop() before the loop goes quiet
+ *    resume     R_RESUME until the next doloop()
+ *    stop       R_STOP until stop() is called, after the loop is joined
+ *    terminate  R_TERMINATE until the process exits
+ *
+ *  usage: lifecyclelatency [rounds]
+ *  The exit code is 1 if the median start or stop latency is 1 ms or more.
+ */
+
+#include <controlbase.h>
+#include <datarepository.h>
+#include <SharedMem.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static const char* PROJECT_NAME = "LifecycleLatency";
+static const char* PROBE_NAME = "LifecycleLatencyProbe";
+static const double FREQUENCY = 10000;
+static const double TARGET_MS = 1.0;
+
+/** Pause is detected when no doloop() is seen for this long */
+static const double QUIET_MS = 2.0;
+
+/** Times the control program acted, steady_clock nanoseconds */
+struct Probe
+{
+    std::atomic<int64_t> start;
+    std::atomic<int64_t> loop;
+    std::atomic<uint64_t> loops;
+    std::atomic<int64_t> stop;
+};
+
+static int64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+static double milliseconds( int64_t pBegin, int64_t pEnd )
+{
+    return (pEnd - pBegin) / 1e6;
+}
+
+/** Control program side: stamps the probe from the user functions */
+class LatencyProbe : public ControlBase
+{
+public:
+    LatencyProbe() : mProbeMemory( PROBE_NAME ) {}
+
+    int initialize()
+    {
+        mProbe = (Probe*)mProbeMemory.ptrToShMem();
+        registerLogVariable( &mValue, "value" );
+        return 0;
+    }
+
+    int start()
+    {
+        mProbe->start = now();
+        return 0;
+    }
+
+    int doloop()
+    {
+        mValue = elapsedTime();
+        mProbe->loop = now();
+        ++mProbe->loops;
+        return 0;
+    }
+
+    int stop()
+    {
+        mProbe->stop = now();
+        return 0;
+    }
+
+private:
+    SharedMem mProbeMemory;
+    Probe* mProbe;
+    double mValue;
+};
+
+static bool waitForState( DataRepository* pDataRepository, StateRequest pState )
+{
+    StateRequest state;
+    for ( int i = 0; i < 10; ++i )
+    {
+        if ( pDataRepository->readState( &state ) > 0 )
+            return state == pState;
+    }
+    return false;
+}
+
+/** Waits until pValue is set after pSent, gives up after a second */
+static bool waitForStamp( const std::atomic<int64_t>& pValue, int64_t pSent )
+{
+    while ( pValue <= pSent )
+    {
+        if ( now() - pSent > 1000000000 )
+            return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+struct Latencies
+{
+    std::vector<double> init, start, pause, resume, stop, terminate;
+};
+
+/** One open, start, pause, resume, stop and terminate of the program */
+static bool runRound( const char* pProgram, Probe* pProbe, Latencies* pLatencies )
+{
+    DataRepository* dataRepository = DataRepository::instance();
+    dataRepository->createMessageQueues();
+    memset( (void*)pProbe, 0, sizeof(Probe) );
+
+    fflush( stdout );
+    int64_t sent = now();
+    pid_t pid = fork();
+    if ( pid == 0 )
+    {
+        execl( "/proc/self/exe", pProgram, PROJECT_NAME, (char*)nullptr );
+        _exit( 1 );
+    }
+
+    bool passed = waitForState( dataRepository, R_INIT ) && dataRepository->readSchema();
+    if ( passed )
+    {
+        dataRepository->createMainControlHeap();
+        dataRepository->sendStateRequest( R_INIT );
+        passed = waitForState( dataRepository, R_INIT );
+        pLatencies->init.push_back( milliseconds( sent, now() ) );
+    }
+
+    if ( passed )
+    {
+        dataRepository->setFrequency( FREQUENCY );
+        dataRepository->setDuration( 1000 );
+        for ( size_t i = 0; i < dataRepository->logVariables().size(); ++i )
+        {
+            dataRepository->logVariables()[i]->setFrequency( 1 );
+            dataRepository->logVariables()[i]->setDuration( 1 );
+        }
+        dataRepository->createLogVariablesHeap();
+
+        sent = now();
+        dataRepository->sendStateRequest( R_START );
+        passed = waitForStamp( pProbe->loop, sent ) && pProbe->start > 0;
+        pLatencies->start.push_back( milliseconds( sent, pProbe->loop ) );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+
+        sent = now();
+        dataRepository->sendStateRequest( R_PAUSE );
+        while ( passed && milliseconds( pProbe->loop, now() ) < QUIET_MS )
+            std::this_thread::yield();
+        pLatencies->pause.push_back( milliseconds( sent, std::max<int64_t>( sent, pProbe->loop ) ) );
+
+        sent = now();
+        dataRepository->sendStateRequest( R_RESUME );
+        passed = passed && waitForStamp( pProbe->loop, sent );
+        pLatencies->resume.push_back( milliseconds( sent, pProbe->loop ) );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+
+        sent = now();
+        dataRepository->sendStateRequest( R_STOP );
+        passed = passed && waitForStamp( pProbe->stop, sent );
+        pLatencies->stop.push_back( milliseconds( sent, pProbe->stop ) );
+        dataRepository->deleteLogVariablesHeap();
+    }
+
+    sent = now();
+    dataRepository->sendStateRequest( R_TERMINATE );
+    if ( !passed )
+        kill( pid, SIGKILL );
+    waitpid( pid, nullptr, 0 );
+    if ( passed )
+        pLatencies->terminate.push_back( milliseconds( sent, now() ) );
+
+    dataRepository->deleteMainControlHeap();
+    dataRepository->deleteMessageQueues();
+    dataRepository->clear();
+    return passed;
+}
+
+static double median( std::vector<double> pValues )
+{
+    if ( pValues.empty() )
+        return 0;
+    std::sort( pValues.begin(), pValues.end() );
+    return pValues[pValues.size() / 2];
+}
+
+static void report( const char* pName, const std::vector<double>& pValues )
+{
+    printf( "  %-10s median %8.3f ms, max %8.3f ms\n", pName, median( pValues ),
+            pValues.empty() ? 0 : *std::max_element( pValues.begin(), pValues.end() ) );
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( argc == 2 && strcmp(argv[1], PROJECT_NAME) == 0 )
+    {
+        LatencyProbe program;
+        program.run( argc, argv );
+        return 0;
+    }
+
+    const int rounds = argc > 1 ? atoi( argv[1] ) : 10;
+
+    SharedMem probeMemory( PROBE_NAME, sizeof(Probe) );
+    Probe* probe = (Probe*)probeMemory.ptrToShMem();
+
+    DataRepository::instance()->setProjectName( PROJECT_NAME );
+    Latencies latencies;
+    for ( int i = 0; i < rounds; ++i )
+    {
+        if ( !runRound( argv[0], probe, &latencies ) )
+        {
+            fprintf( stderr, "Round %d failed\n", i );
+            return 1;
+        }
+    }
+
+    printf( "%d rounds at %.0f Hz\n", rounds, FREQUENCY );
+    report( "init", latencies.init );
+    report( "start", latencies.start );
+    report( "pause", latencies.pause );
+    report( "resume", latencies.resume );
+    report( "stop", latencies.stop );
+    report( "terminate", latencies.terminate );
+
+    return median( latencies.start ) < TARGET_MS && median( latencies.stop ) < TARGET_MS ? 0 : 1;
+}
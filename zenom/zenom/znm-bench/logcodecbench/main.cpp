@@ -0,0 +1,214 @@
+/*
+ * logcodecbench
+ *
+ *  Compression ratio and speed of LogCodec on the records of the example
+ *  models. Each example is started as the control program, as in
+ *  logstreambench, and run with log streaming on and compression off.
+ *  The records of the streamed file are then encoded chunk by chunk as
+ *  LogStreamer would, decoded again and compared bit by bit.
+ *
+ *  usage: logcodecbench [seconds] [frequency] [program ...]
+ *  Without programs the Sine, SineFilter and BouncingBall examples next
+ *  to the bin directory are used. The exit code is 1 if a program could
+ *  not be run or a decoded chunk differs from the records.
+ */
+
+#include <datarepository.h>
+#include <logfilereader.h>
+#include <logcodec.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <limits.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static const char* PROJECT_NAME = "LogCodecBench";
+static const char* EXAMPLES[] = { "Sine", "SineFilter", "BouncingBall" };
+static const int REPEATS = 20;
+
+static bool waitForState( DataRepository* pDataRepository, StateRequest pState )
+{
+    StateRequest state;
+    for ( int i = 0; i < 10; ++i )
+    {
+        if ( pDataRepository->readState( &state ) > 0 )
+            return state == pState;
+    }
+    return false;
+}
+
+/** Runs pProgram as the control program and streams its log variables */
+static bool streamProgram( const std::string& pProgram, double pSeconds, double pFrequency )
+{
+    DataRepository* dataRepository = DataRepository::instance();
+    dataRepository->setProjectName( PROJECT_NAME );
+    dataRepository->createMessageQueues();
+
+    fflush( stdout );
+    pid_t pid = fork();
+    if ( pid == 0 )
+    {
+        execl( pProgram.c_str(), pProgram.c_str(), PROJECT_NAME, (char*)nullptr );
+        _exit( 1 );
+    }
+
+    bool started = waitForState( dataRepository, R_INIT ) && dataRepository->readSchema();
+    if ( started )
+    {
+        dataRepository->createMainControlHeap();
+        dataRepository->sendStateRequest( R_INIT );
+        started = waitForState( dataRepository, R_INIT );
+    }
+
+    if ( started )
+    {
+        dataRepository->setFrequency( pFrequency );
+        dataRepository->setDuration( pSeconds );
+        for ( size_t i = 0; i < dataRepository->logVariables().size(); ++i )
+        {
+            dataRepository->logVariables()[i]->setFrequency( pFrequency );
+            dataRepository->logVariables()[i]->setDuration( pSeconds );
+        }
+        dataRepository->setLogStreaming( true );
+        dataRepository->setLogCompression( false );
+        dataRepository->createLogVariablesHeap();
+
+        // The loop sends R_STOP when the duration is over.
+        StateRequest state = R_START;
+        dataRepository->sendStateRequest( R_START );
+        while ( state != R_STOP )
+        {
+            if ( dataRepository->readState( &state, 100 ) < 0 )
+                state = R_START;
+        }
+        dataRepository->sendStateRequest( R_STOP );
+    }
+
+    dataRepository->sendStateRequest( R_TERMINATE );
+    if ( !started )
+        kill( pid, SIGKILL );
+    waitpid( pid, nullptr, 0 );
+
+    dataRepository->deleteLogVariablesHeap();
+    dataRepository->deleteMainControlHeap();
+    dataRepository->deleteMessageQueues();
+    dataRepository->clear();
+    return started;
+}
+
+/**
+ * Encodes the chunks of the streamed file again and decodes them.
+ * @return false if a decoded chunk differs from its records
+ */
+static bool measureCodec( const std::string& pName, const std::string& pFileName )
+{
+    LogFileReader reader;
+    if ( !reader.open( pFileName ) )
+    {
+        fprintf( stderr, "%s could not be read\n", pFileName.c_str() );
+        return false;
+    }
+
+    bool exact = true;
+    size_t rawBytes = 0;
+    size_t encodedBytes = 0;
+    double encodeTime = 0;
+    double decodeTime = 0;
+    for ( unsigned int f = 0; f < reader.frames().size(); ++f )
+    {
+        const LogFileReader::Frame& frame = reader.frames()[f];
+        double begin, end;
+        std::vector<double> records;
+        if ( !reader.timeRange( f, &begin, &end ) ||
+             reader.readRecords( f, begin, end, records ) == 0 )
+            continue;
+
+        std::vector<double> decoded( records.size() );
+        size_t first = 0;
+        for ( size_t c = 0; c < frame.chunks.size(); ++c )
+        {
+            const uint32_t count = frame.chunks[c].chunk.count;
+            const double* chunk = &records[first * frame.recordSize];
+            std::vector<uint8_t> encoded;
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for ( int r = 0; r < REPEATS; ++r )
+            {
+                encoded.clear();
+                LogCodec::encode( chunk, count, frame.recordSize, encoded );
+            }
+            encodeTime += std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start ).count();
+
+            start = std::chrono::steady_clock::now();
+            for ( int r = 0; r < REPEATS; ++r )
+            {
+                exact &= LogCodec::decode( encoded.data(), encoded.size(), count,
+                                           frame.recordSize,
+                                           &decoded[first * frame.recordSize] );
+            }
+            decodeTime += std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start ).count();
+
+            encodedBytes += encoded.size();
+            first += count;
+        }
+
+        rawBytes += records.size() * sizeof(double);
+        exact &= memcmp( decoded.data(), records.data(), records.size() * sizeof(double) ) == 0;
+    }
+    reader.close();
+
+    const double megabytes = rawBytes / 1e6 * REPEATS;
+    printf( "  %-14s %8.1f KB -> %8.1f KB (%.1fx), encode %.0f MB/s, decode %.0f MB/s%s\n",
+            pName.c_str(), rawBytes / 1024.0, encodedBytes / 1024.0,
+            encodedBytes ? (double)rawBytes / encodedBytes : 0.0,
+            megabytes / encodeTime, megabytes / decodeTime,
+            exact ? "" : ", DECODE MISMATCH" );
+    return exact;
+}
+
+int main( int argc, char* argv[] )
+{
+    const double seconds = argc > 1 ? atof( argv[1] ) : 5;
+    const double frequency = argc > 2 ? atof( argv[2] ) : 1000;
+
+    std::vector<std::string> programs;
+    for ( int i = 3; i < argc; ++i )
+        programs.push_back( argv[i] );
+    if ( programs.empty() )
+    {
+        // The examples are built in place, next to the bin directory.
+        char path[PATH_MAX];
+        ssize_t length = readlink( "/proc/self/exe", path, sizeof(path) - 1 );
+        path[length > 0 ? length : 0] = '\0';
+        const std::string bin = dirname( path );
+        for ( size_t i = 0; i < sizeof(EXAMPLES) / sizeof(EXAMPLES[0]); ++i )
+            programs.push_back( bin + "/../examples/" + EXAMPLES[i] + "/" + EXAMPLES[i] );
+    }
+
+    printf( "LogCodec on streamed records, %.0f Hz for %.1f s\n", frequency, seconds );
+    const std::string fileName = std::string( PROJECT_NAME ) + ".zlog";
+    bool passed = true;
+    for ( size_t i = 0; i < programs.size(); ++i )
+    {
+        const std::string name = programs[i].substr( programs[i].find_last_of( '/' ) + 1 );
+        if ( !streamProgram( programs[i], seconds, frequency ) )
+        {
+            fprintf( stderr, "%s did not start\n", programs[i].c_str() );
+            passed = false;
+            continue;
+        }
+
+        passed &= measureCodec( name, fileName );
+        remove( fileName.c_str() );
+    }
+
+    return passed ? 0 : 1;
+}
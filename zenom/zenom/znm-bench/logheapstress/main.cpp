@@ -0,0 +1,159 @@
+/*
+ * logheapstress
+ *
+ *  Stress test of the lock-free log heap. A periodic task writes a record
+ *  into a LogFrame at 10 kHz while several reader threads take the latest
+ *  record with copyLastRecord(), as the GUI does. Every record the writer
+ *  produces holds the same value in all elements and a time stamp derived
+ *  from it, so a record mixed from two writes is detected.
+ *
+ *  usage: logheapstress [seconds] [readers] [ring capacity]
+ *  The exit code is 1 if a torn or out of order record was read.
+ */
+
+#include <logvariable.h>
+#include <logframe.h>
+#include <TaskXn.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+static const double FREQUENCY = 10000;
+static const unsigned int ROWS = 8;
+static const unsigned int COLS = 8;
+static const unsigned int ELEMENTS = ROWS * COLS;
+
+class Writer : public TaskXn
+{
+public:
+    Writer( LogFrame* pFrame, double* pData )
+        : TaskXn( "logheapstress", std::chrono::duration<double>(1 / FREQUENCY),
+                  TaskXn::maxPriority() )
+        , mFrame( pFrame )
+        , mData( pData )
+        , mTick( 0 )
+    {
+
+    }
+
+    uint64_t ticks() { return mTick; }
+
+protected:
+    virtual void run()
+    {
+        const uint64_t tick = mTick + 1;
+        for ( unsigned int i = 0; i < ELEMENTS; ++i )
+            mData[i] = tick;
+        mFrame->insertToHeap( tick / FREQUENCY );
+        mTick = tick;
+    }
+
+private:
+    LogFrame* mFrame;
+    double* mData;
+    std::atomic<uint64_t> mTick;
+};
+
+struct ReaderResult
+{
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t backwards;
+};
+
+/** The heap is shared memory in zenom; here both sides bind the same buffer. */
+static void reader( void* pHeap, const std::atomic<bool>* pStop, ReaderResult* pResult )
+{
+    LogVariable logVariable( nullptr, "stress", ROWS, COLS );
+    LogFrame frame;
+    frame.addLogVariable( &logVariable );
+    frame.bindHeap( pHeap );
+
+    // The only variable of the frame follows the time stamp.
+    const size_t offset = sizeof(double);
+    std::vector<double> record( ELEMENTS );
+    double time;
+    double last = 0;
+    while ( !*pStop )
+    {
+        if ( !frame.copyLastRecord( record.data(), offset, VARIABLE_DOUBLE,
+                                    ELEMENTS, &time ) )
+            continue;
+
+        ++pResult->reads;
+        for ( unsigned int i = 0; i < ELEMENTS; ++i )
+        {
+            if ( record[i] != record[0] || time != record[0] / FREQUENCY )
+            {
+                ++pResult->torn;
+                break;
+            }
+        }
+
+        if ( record[0] < last )
+            ++pResult->backwards;
+        last = record[0];
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    const int seconds = argc > 1 ? atoi( argv[1] ) : 5;
+    const int readers = argc > 2 ? atoi( argv[2] ) : 4;
+    const unsigned int ring = argc > 3 ? atoi( argv[3] ) : 1024;
+
+    double mainHeap[3];
+    std::vector<double> data( ELEMENTS );
+
+    // GUI side creates the heap, the control side binds and writes it.
+    LogVariable guiVariable( nullptr, "stress", ROWS, COLS );
+    guiVariable.setMainHeapAddr( mainHeap );
+    guiVariable.setFrequency( FREQUENCY );
+    guiVariable.setDuration( seconds + 1 );
+    guiVariable.setRingCapacity( ring );
+
+    LogFrame guiFrame;
+    guiFrame.addLogVariable( &guiVariable );
+    std::vector<uint64_t> heap( guiFrame.heapByteSize() / sizeof(uint64_t) + 1 );
+    guiFrame.createHeap( heap.data() );
+
+    LogVariable controlVariable( data.data(), "stress", ROWS, COLS );
+    LogFrame controlFrame;
+    controlFrame.addLogVariable( &controlVariable );
+    controlFrame.bindHeap( heap.data() );
+
+    std::atomic<bool> stop( false );
+    std::vector<ReaderResult> results( readers, ReaderResult() );
+    std::vector<std::thread> threads;
+    for ( int i = 0; i < readers; ++i )
+        threads.push_back( std::thread(reader, heap.data(), &stop, &results[i]) );
+
+    Writer writer( &controlFrame, data.data() );
+    writer.runTask();
+    sleep( seconds );
+    writer.requestPeriodicTaskTermination();
+    writer.join();
+
+    stop = true;
+    ReaderResult total = ReaderResult();
+    for ( int i = 0; i < readers; ++i )
+    {
+        threads[i].join();
+        total.reads += results[i].reads;
+        total.torn += results[i].torn;
+        total.backwards += results[i].backwards;
+    }
+
+    printf( "ring %u, %d readers: %lu records written, %u overruns, "
+            "%lu reads, %lu torn, %lu out of order\n",
+            ring, readers, (unsigned long)writer.ticks(), writer.overruns(),
+            (unsigned long)total.reads, (unsigned long)total.torn,
+            (unsigned long)total.backwards );
+
+    controlFrame.deleteHeap();
+    guiFrame.deleteHeap();
+    return total.torn || total.backwards ? 1 : 0;
+}
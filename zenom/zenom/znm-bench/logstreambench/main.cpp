@@ -0,0 +1,166 @@
+/*
+ * logstreambench
+ *
+ *  Throughput of log streaming. The same binary is both sides of a
+ *  project: run without a project name it plays the GUI, starts itself
+ *  as the control program and runs a 500 channel model at 10 kHz with
+ *  log streaming on. When the run is over the streamed file is read back
+ *  with LogFileReader and compared to the records the loop produced.
+ *
+ *  usage: logstreambench [seconds] [ring capacity]
+ *  The exit code is 1 if records are missing from the file without
+ *  being counted as dropped.
+ */
+
+#include <controlbase.h>
+#include <datarepository.h>
+#include <logfilereader.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static const char* PROJECT_NAME = "LogStreamBench";
+static const double FREQUENCY = 10000;
+static const int CHANNELS = 500;
+
+/** Control program side: 500 scalar channels updated every tick */
+class StreamSource : public ControlBase
+{
+public:
+    int initialize()
+    {
+        for ( int i = 0; i < CHANNELS; ++i )
+            registerLogVariable( &mChannels[i], "ch" + std::to_string(i) );
+        mTick = 0;
+        return 0;
+    }
+
+    int doloop()
+    {
+        ++mTick;
+        for ( int i = 0; i < CHANNELS; ++i )
+            mChannels[i] = mTick + i;
+        return 0;
+    }
+
+private:
+    double mChannels[CHANNELS];
+    double mTick;
+};
+
+static bool waitForState( DataRepository* pDataRepository, StateRequest pState )
+{
+    StateRequest state;
+    for ( int i = 0; i < 10; ++i )
+    {
+        if ( pDataRepository->readState( &state ) > 0 )
+            return state == pState;
+    }
+    return false;
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( argc == 2 && strcmp(argv[1], PROJECT_NAME) == 0 )
+    {
+        StreamSource source;
+        source.run( argc, argv );
+        return 0;
+    }
+
+    const double seconds = argc > 1 ? atof( argv[1] ) : 10;
+    const unsigned int ring = argc > 2 ? atoi( argv[2] ) : 0;
+
+    DataRepository* dataRepository = DataRepository::instance();
+    dataRepository->setProjectName( PROJECT_NAME );
+    dataRepository->createMessageQueues();
+
+    pid_t pid = fork();
+    if ( pid == 0 )
+    {
+        execl( "/proc/self/exe", argv[0], PROJECT_NAME, (char*)nullptr );
+        _exit( 1 );
+    }
+
+    if ( !waitForState( dataRepository, R_INIT ) || !dataRepository->readSchema() )
+    {
+        fprintf( stderr, "The control program did not start\n" );
+        return 1;
+    }
+    dataRepository->createMainControlHeap();
+    dataRepository->sendStateRequest( R_INIT );
+    if ( !waitForState( dataRepository, R_INIT ) )
+    {
+        fprintf( stderr, "The control program did not bind the control heap\n" );
+        return 1;
+    }
+
+    dataRepository->setFrequency( FREQUENCY );
+    dataRepository->setDuration( seconds );
+    for ( size_t i = 0; i < dataRepository->logVariables().size(); ++i )
+    {
+        dataRepository->logVariables()[i]->setFrequency( FREQUENCY );
+        dataRepository->logVariables()[i]->setDuration( seconds );
+    }
+    dataRepository->setLogRingCapacity( ring );
+    dataRepository->setLogStreaming( true );
+    dataRepository->createLogVariablesHeap();
+
+    // The loop sends R_STOP when the duration is over.
+    double maxLag = 0;
+    StateRequest state = R_START;
+    const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    dataRepository->sendStateRequest( R_START );
+    while ( state != R_STOP )
+    {
+        if ( dataRepository->readState( &state, 10 ) < 0 )
+            state = R_START;
+        maxLag = std::max( maxLag, dataRepository->logStreamLag() );
+    }
+    const double elapsed = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - begin ).count();
+
+    // The streamer writes the rest of the heaps and closes the file on stop.
+    dataRepository->sendStateRequest( R_STOP );
+    dataRepository->sendStateRequest( R_TERMINATE );
+    waitpid( pid, nullptr, 0 );
+
+    const double dropped = dataRepository->logStreamDropped();
+    const double overruns = dataRepository->overruns();
+    const double ticks = dataRepository->elapsedTimeSecond() * FREQUENCY;
+    dataRepository->deleteLogVariablesHeap();
+    dataRepository->deleteMainControlHeap();
+    dataRepository->deleteMessageQueues();
+
+    const std::string fileName = std::string( PROJECT_NAME ) + ".zlog";
+    struct stat fileInfo;
+    LogFileReader reader;
+    if ( stat( fileName.c_str(), &fileInfo ) != 0 || !reader.open( fileName ) ||
+         reader.frames().empty() )
+    {
+        fprintf( stderr, "%s could not be read\n", fileName.c_str() );
+        return 1;
+    }
+
+    uint64_t records = 0;
+    for ( unsigned int i = 0; i < reader.frames().size(); ++i )
+        records += reader.recordCount( i );
+    reader.close();
+    remove( fileName.c_str() );
+
+    const double megabytes = fileInfo.st_size / 1e6;
+    printf( "%d channels at %.0f Hz for %.1f s, ring %u\n",
+            CHANNELS, FREQUENCY, seconds, ring );
+    printf( "  %lu records streamed, %.0f dropped, %.0f loop ticks\n",
+            (unsigned long)records, dropped, ticks );
+    printf( "  %.1f MB written, %.1f MB/s, max lag %.3f s, %.0f overruns\n",
+            megabytes, megabytes / elapsed, maxLag, overruns );
+
+    // The loop may run one tick past the duration.
+    return records + dropped + 1 < ticks ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * variableviewbench
+ *
+ *  Time to open a project with large matrix variables in the variable
+ *  views. The repository gets one control and one log variable of
+ *  rows x cols elements, as readSchema() would create them, and the
+ *  views go through the same calls as Zenom::openProject(): the variable
+ *  lists are set, the widgets are shown and the project settings are
+ *  loaded. A LogVariableTreeWidget, as in the gauge and plot dialogs,
+ *  is filled too.
+ *
+ *  usage: variableviewbench [rows] [cols]
+ *  The exit code is 1 if opening takes a second or more.
+ *  Without a display run it with -platform offscreen (Qt 5) or under Xvfb.
+ */
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QDir>
+#include <QFile>
+#include <cstdio>
+#include <datarepository.h>
+#include "controlvariableswidget.h"
+#include "logvariableswidget.h"
+#include "widget/logvariabletreewidget.h"
+
+static const char* PROJECT_NAME = "VariableViewBench";
+
+/** Shows the widget and lets it lay out and paint the rows on screen */
+static void showWidget( QWidget* pWidget )
+{
+    pWidget->resize( 800, 600 );
+    pWidget->show();
+    QApplication::processEvents();
+}
+
+int main( int argc, char* argv[] )
+{
+    QApplication application( argc, argv );
+    const QStringList arguments = application.arguments();
+    const unsigned int rows = arguments.size() > 1 ? arguments[1].toUInt() : 100;
+    const unsigned int cols = arguments.size() > 2 ? arguments[2].toUInt() : 100;
+
+    DataRepository* dataRepository = DataRepository::instance();
+    dataRepository->setProjectName( PROJECT_NAME );
+    dataRepository->insertControlVariable( new ControlVariable(NULL, "gain", rows, cols) );
+    dataRepository->insertLogVariable( new LogVariable(NULL, "state", rows, cols) );
+    dataRepository->createMainControlHeap();
+
+    // Settings of the project, written by a first open.
+    const QString fileName = QDir::temp().filePath( QString(PROJECT_NAME) + ".znm" );
+    {
+        ControlVariablesWidget controlVariablesWidget;
+        LogVariablesWidget logVariablesWidget;
+        controlVariablesWidget.setControlVariableList( dataRepository->controlVariables() );
+        logVariablesWidget.setLogVariableList( dataRepository->logVariables() );
+
+        QSettings settings( fileName, QSettings::IniFormat );
+        settings.beginGroup( "zenom" );
+        logVariablesWidget.saveSettings( settings );
+        controlVariablesWidget.saveSettings( settings );
+        settings.endGroup();
+    }
+
+    ControlVariablesWidget controlVariablesWidget;
+    LogVariablesWidget logVariablesWidget;
+    LogVariableTreeWidget logVariableTreeWidget( NULL );
+
+    QElapsedTimer timer;
+    timer.start();
+    controlVariablesWidget.setControlVariableList( dataRepository->controlVariables() );
+    logVariablesWidget.setLogVariableList( dataRepository->logVariables() );
+    logVariableTreeWidget.setLogVariableList( dataRepository->logVariables() );
+    showWidget( &controlVariablesWidget );
+    showWidget( &logVariablesWidget );
+    showWidget( &logVariableTreeWidget );
+    const double listTime = timer.nsecsElapsed() / 1e6;
+
+    timer.restart();
+    {
+        QSettings settings( fileName, QSettings::IniFormat );
+        settings.beginGroup( "zenom" );
+        logVariablesWidget.loadSettings( settings );
+        controlVariablesWidget.loadSettings( settings );
+        settings.endGroup();
+    }
+    QApplication::processEvents();
+    const double settingsTime = timer.nsecsElapsed() / 1e6;
+
+    controlVariablesWidget.clear();
+    logVariablesWidget.clear();
+    logVariableTreeWidget.setLogVariableList( LogVariableList() );
+    dataRepository->deleteMainControlHeap();
+    dataRepository->clear();
+    QFile::remove( fileName );
+
+    const double openTime = listTime + settingsTime;
+    printf( "%ux%u control and log variables, %u elements each\n", rows, cols, rows * cols );
+    printf( "  views filled and shown in %.1f ms, settings loaded in %.1f ms\n",
+            listTime, settingsTime );
+    printf( "  open time %.1f ms\n", openTime );
+    return openTime < 1000 ? 0 : 1;
+}
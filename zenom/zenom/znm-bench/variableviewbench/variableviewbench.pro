@@ -0,0 +1,48 @@
+#--------------------------------------------------------------
+#
+# Zenom Hard Real-Time Simulation Enviroment
+# Copyright (C) 2013
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the Zenom License, Version 1.0
+#
+#--------------------------------------------------------------
+
+include( ../bench.pri )
+
+CONFIG += qt
+QT += core gui
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+
+TARGET = variableviewbench
+
+# Variable views of the GUI, built into the benchmark
+ZENOM_GUI = ../../zenom
+INCLUDEPATH += $${ZENOM_GUI}
+DEPENDPATH += $${ZENOM_GUI}
+
+SOURCES += main.cpp \
+	$${ZENOM_GUI}/controlvariableswidget.cpp \
+	$${ZENOM_GUI}/logvariableswidget.cpp \
+	$${ZENOM_GUI}/logtriggerdialog.cpp \
+	$${ZENOM_GUI}/widget/checkedheader.cpp \
+	$${ZENOM_GUI}/widget/controlvariablemodel.cpp \
+	$${ZENOM_GUI}/widget/logvariabletablemodel.cpp \
+	$${ZENOM_GUI}/widget/logvariablemodel.cpp \
+	$${ZENOM_GUI}/widget/logvariabletreewidget.cpp \
+	$${ZENOM_GUI}/widget/logvariableitem.cpp
+
+HEADERS += \
+	$${ZENOM_GUI}/controlvariableswidget.h \
+	$${ZENOM_GUI}/logvariableswidget.h \
+	$${ZENOM_GUI}/logtriggerdialog.h \
+	$${ZENOM_GUI}/widget/checkedheader.h \
+	$${ZENOM_GUI}/widget/controlvariablemodel.h \
+	$${ZENOM_GUI}/widget/logvariabletablemodel.h \
+	$${ZENOM_GUI}/widget/logvariablemodel.h \
+	$${ZENOM_GUI}/widget/logvariabletreewidget.h
+
+FORMS += \
+	$${ZENOM_GUI}/controlvariableswidget.ui \
+	$${ZENOM_GUI}/logvariableswidget.ui \
+	$${ZENOM_GUI}/logtriggerdialog.ui
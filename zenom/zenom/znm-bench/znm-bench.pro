@@ -0,0 +1,19 @@
+#--------------------------------------------------------------
+#
+# Zenom Hard Real-Time Simulation Enviroment
+# Copyright (C) 2013
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the Zenom License, Version 1.0
+#
+#--------------------------------------------------------------
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    logheapstress \
+    logstreambench \
+    logcodecbench \
+    lifecyclelatency \
+    gaugepaintbench \
+    variableviewbench
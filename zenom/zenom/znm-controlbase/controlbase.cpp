@@ -1,11 +1,14 @@
 #include "controlbase.h"
 
 #include <sys/mman.h>
+#include <algorithm>
+#include <thread>
 
 
 
 using namespace std::chrono;
 ControlBase::ControlBase(/*int argc, char* argv[]*/)
+    : mLogStreamer(nullptr)
 {
     mDataRepository = DataRepository::instance();
 }
@@ -51,6 +54,30 @@ void ControlBase::registerControlVariable(double& pVariable,
     registerControlVariable( &pVariable, pName, 1, 1, pDesc );
 }
 
+ControlSpan ControlBase::registerControlSpan(const std::string& pName,
+                                            unsigned int pRow,
+                                            unsigned int pCol,
+                                            const std::string& pDesc)
+{
+    ControlVariable* variable = new ControlVariable( pName, pRow, pCol, pDesc );
+    mDataRepository->insertControlVariable( variable );
+    return ControlSpan( variable );
+}
+
+ControlSpan ControlBase::registerControlSpan(const double* pValues,
+                                            const std::string& pName,
+                                            unsigned int pRow,
+                                            unsigned int pCol,
+                                            const std::string& pDesc)
+{
+    ControlSpan span = registerControlSpan( pName, pRow, pCol, pDesc );
+
+    // Heap'e baglanmadan once degiskenin kendi belleginde tutulur.
+    ControlVariable* variable = mDataRepository->controlVariables().back();
+    std::copy( pValues, pValues + variable->size(), variable->data() );
+    return span;
+}
+
 
 void ControlBase::run(int argc, char *argv[])
 {
@@ -108,14 +135,14 @@ void ControlBase::initializeControlBase()
                      " function." << std::endl;
     }
 
-    mDataRepository->writeVariablesToFile();
+    mDataRepository->publishSchema();
     mDataRepository->bindMessageQueues();
     mDataRepository->sendStateRequest( R_INIT );
 
     StateRequest dumpState;
     while ( mDataRepository->readState( &dumpState ) < 0 )
         // false (if an error occurred or the operation timed out).
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ;
 
     // Send message to GUI to read variables
      mDataRepository->bindMainControlHeap();
@@ -126,12 +153,26 @@ void ControlBase::initializeControlBase()
         mDataRepository->controlVariables()[i]->copyToHeap();
     }
 
+    prefaultTaskStacks();
+
     mDataRepository->sendStateRequest( R_INIT );
 
     // Send message to GUIe.flush();
     mState = STOPPED;
 }
 
+// mlockall(MCL_FUTURE) altinda yeni bir thread'in yigini olusturulurken
+// tamamen bellege alinir, bu da start'i birkac ms geciktirir. Loop ve
+// streamer task'lari kadar thread baslatilip bitirilir; glibc biten
+// thread'lerin yiginlarini saklar ve start'ta bunlari kullanir.
+void ControlBase::prefaultTaskStacks()
+{
+    std::thread loopStack( []{} );
+    std::thread streamerStack( []{} );
+    loopStack.join();
+    streamerStack.join();
+}
+
 //============================================================================//
 //		START OPERATIONS													  //
 //============================================================================//
@@ -179,6 +220,28 @@ void ControlBase::startControlBase()
         }
         else
         {
+            // Log heaps are drained to disk by a non real-time task, the
+            // loop task never does file I/O.
+            if ( mDataRepository->logStreaming() )
+            {
+                mLogStreamer = new LogStreamer(
+                                mDataRepository,
+                                std::chrono::duration<double>( 0.05 ),
+                                mDataRepository->projectName() + "LogStreamer"
+                            );
+                if ( mLogStreamer->open( mDataRepository->projectName() + ".zlog" ) )
+                {
+                    mLogStreamer->runTask();
+                }
+                else
+                {
+                    std::cerr << "Log file could not be created, log streaming "
+                                 "is disabled." << std::endl;
+                    delete mLogStreamer;
+                    mLogStreamer = nullptr;
+                }
+            }
+
             mState = RUNNING;
             mLoopTask = new LoopTask(
                             this,
@@ -208,19 +271,21 @@ void ControlBase::resumeControlBase()
 //============================================================================//
 void ControlBase::syncMainHeap()
 {
-    for (size_t i = 0; i < mDataRepository->controlVariables().size(); ++i)
-    {
-        mDataRepository->controlVariables()[i]->copyFromHeap();
-    }
+    mDataRepository->updateControlVariables();
 
     mDataRepository->setElapsedTimeSecond(mLoopTask->elapsedTimeSec() );
     mDataRepository->setOverruns( mLoopTask->overruns() );
 }
 
+void ControlBase::releaseMainHeap()
+{
+    mDataRepository->releaseControlVariables();
+}
+
 
-void ControlBase::logVariables( double pSimTime )
+void ControlBase::logVariables( uint64_t pTick, double pSimTime )
 {
-    mDataRepository->sampleLogVariable( pSimTime );
+    mDataRepository->sampleLogVariable( pTick, pSimTime );
 }
 
 
@@ -237,6 +302,16 @@ void ControlBase::stopControlBase()
         //...
         delete mLoopTask;
 
+        mDataRepository->releaseControlVariables();
+
+        // Write the records the streamer has not reached yet.
+        if ( mLogStreamer )
+        {
+            mLogStreamer->close();
+            delete mLogStreamer;
+            mLogStreamer = nullptr;
+        }
+
         mDataRepository->unbindLogVariableHeap();
         std::cerr << "unbinded from log variable heap" << std::endl;
 
@@ -268,8 +343,11 @@ void ControlBase::stopControlBase()
 //============================================================================//
 void ControlBase::terminateControlBase()
 {
+    // Wakes the GUI listener, which exits without waiting for a timeout.
+    mDataRepository->sendStateRequest( R_TERMINATE );
     mDataRepository->unbindMessageQueues();
     mDataRepository->unbindMainControlHeap();
+    mDataRepository->deleteSchema();
 
     mState = TERMINATED;
 	terminate();	// User Function
@@ -3,11 +3,13 @@
 
 #include <vector>
 #include <datarepository.h>
+#include <controlspan.h>
 #include <MsgQueue.h>
 #include <iostream>
 #include <fstream>
 #include "looptask.h"
 #include "lifecycletask.h"
+#include "logstreamer.h"
 
 
 //#define SECOND_TO_NANO (1000000000)
@@ -37,6 +39,22 @@ class ControlBase
 			const std::string& pName,
 			const std::string& pDesc= "");
 
+	/**
+	 * float, int32_t, int64_t and bool variables are logged in their own
+	 * type and read back as double. Other types do not compile.
+	 */
+	template <typename T>
+	void registerLogVariable(T *pVariable,
+			const std::string& pName,
+			unsigned int pRow = 1,
+			unsigned int pCol = 1,
+			const std::string& pDesc= "");
+
+	template <typename T>
+	void registerLogVariable(T& pVariable,
+			const std::string& pName,
+			const std::string& pDesc= "");
+
 	void registerControlVariable(double *pVariable,
 			const std::string& pName,
 			unsigned int pRow = 1,
@@ -47,6 +65,43 @@ class ControlBase
 			const std::string& pName,
 			const std::string& pDesc= "");
 
+	/**
+	 * float, int32_t, int64_t and bool control variables. The GUI edits
+	 * them as double; values are converted when they are copied in.
+	 */
+	template <typename T>
+	void registerControlVariable(T *pVariable,
+			const std::string& pName,
+			unsigned int pRow = 1,
+			unsigned int pCol = 1,
+			const std::string& pDesc= "");
+
+	template <typename T>
+	void registerControlVariable(T& pVariable,
+			const std::string& pName,
+			const std::string& pDesc= "");
+
+	/**
+	 * Registers a control variable whose values are read in place from
+	 * the shared memory instead of being copied into a user variable
+	 * every cycle. Suited to large matrices such as lookup tables.
+	 * The span is read only; the initial values are zero.
+	 */
+	ControlSpan registerControlSpan(const std::string& pName,
+			unsigned int pRow = 1,
+			unsigned int pCol = 1,
+			const std::string& pDesc= "");
+
+	/**
+	 * Same as above, with pRow * pCol initial values copied row by row
+	 * from pValues.
+	 */
+	ControlSpan registerControlSpan(const double* pValues,
+			const std::string& pName,
+			unsigned int pRow = 1,
+			unsigned int pCol = 1,
+			const std::string& pDesc= "");
+
 	void run(int argc, char *argv[]);
 
 	virtual int initialize(){return 0;}
@@ -83,6 +138,7 @@ class ControlBase
 	//		INITIALIZE OPERATIONS											  //
 	//========================================================================//
 	void initializeControlBase();
+	void prefaultTaskStacks();
 
 	//========================================================================//
 	//		START OPERATIONS                                                  //
@@ -95,8 +151,9 @@ class ControlBase
 	//		LOOP OPERATIONS									   			      //
 	//========================================================================//
 	void syncMainHeap();
+	void releaseMainHeap();
 	// Loop Task Elapsed Time
-	void logVariables( double pSimTime );
+	void logVariables( uint64_t pTick, double pSimTime );
 
 	//========================================================================//
 	//		STOP OPERATIONS														  //
@@ -110,6 +167,7 @@ class ControlBase
 
 	LifeCycleTask* mLifeCycleTask;
 	LoopTask* mLoopTask;
+	LogStreamer* mLogStreamer;
 	State mState;
 	DataRepository* mDataRepository;
 
@@ -117,4 +175,46 @@ class ControlBase
 
 };
 
+template <typename T>
+void ControlBase::registerLogVariable(T *pVariable,
+                                      const std::string& pName,
+                                      unsigned int pRow,
+                                      unsigned int pCol,
+                                      const std::string& pDesc)
+{
+    mDataRepository->insertLogVariable(
+                new LogVariable( pVariable, pName, pRow, pCol, pDesc,
+                                 VariableTypeOf<T>::value )
+                );
+}
+
+template <typename T>
+void ControlBase::registerLogVariable(T& pVariable,
+                                      const std::string& pName,
+                                      const std::string& pDesc)
+{
+    registerLogVariable( &pVariable, pName, 1, 1, pDesc );
+}
+
+template <typename T>
+void ControlBase::registerControlVariable(T *pVariable,
+                                          const std::string& pName,
+                                          unsigned int pRow,
+                                          unsigned int pCol,
+                                          const std::string& pDesc)
+{
+    mDataRepository->insertControlVariable(
+                new ControlVariable( pVariable, pName, pRow, pCol, pDesc,
+                                     VariableTypeOf<T>::value )
+                );
+}
+
+template <typename T>
+void ControlBase::registerControlVariable(T& pVariable,
+                                          const std::string& pName,
+                                          const std::string& pDesc)
+{
+    registerControlVariable( &pVariable, pName, 1, 1, pDesc );
+}
+
 #endif /* CONTROLBASE_H_ */
@@ -9,7 +9,6 @@
 #include <datarepository.h>
 #include "lifecycletask.h"
 #include "controlbase.h"
-#include <unistd.h>
 
 
 LifeCycleTask::LifeCycleTask( ControlBase* pControlBase , std::string name)
@@ -61,7 +60,6 @@ void LifeCycleTask::run()
                         break;
                 }
             }
-            usleep(100*1000); //100ms 10hz
         }
     }
     catch (std::system_error e)
@@ -0,0 +1,285 @@
+/*
+ * LogStreamer.cpp
+ *
+ *  Drains the log heaps into a file while the loop runs.
+ */
+
+#include "logstreamer.h"
+#include <datarepository.h>
+#include <logcodec.h>
+#include <algorithm>
+#include <cstring>
+
+// An open chunk is written even if it is not full once it is this old,
+// so a crash loses at most this much of a slow frame.
+static const std::chrono::seconds MAX_CHUNK_AGE(1);
+
+LogStreamer::LogStreamer( DataRepository* pDataRepository,
+                          std::chrono::duration<double> period,
+                          std::string name )
+    : TaskXn(name, period, TaskXn::normalPriority())
+    , mDataRepository(pDataRepository)
+    , mFileOffset(0)
+    , mCompression(false)
+    , mDropped(0)
+    , mClosing(false)
+{
+}
+
+bool LogStreamer::open( const std::string& pFileName )
+{
+    mFile.open( pFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( !mFile.is_open() )
+        return false;
+
+    const LogFrameList& frames = mDataRepository->logFrames();
+
+    LogFileHeader header;
+    std::memcpy( header.magic, "ZLOG", 4 );
+    header.version = LOG_FILE_VERSION;
+    header.frameCount = frames.size();
+    header.reserved = 0;
+    mFile.write( (const char*)&header, sizeof(header) );
+
+    mChunks.assign( frames.size(), Chunk() );
+    for (unsigned int i = 0; i < frames.size(); ++i)
+    {
+        const std::vector<LogVariable*>& variables = frames[i]->logVariables();
+
+        LogFileFrame frame;
+        frame.frequency = frames[i]->frequency();
+        frame.recordSize = frames[i]->recordSize();
+        frame.variableCount = variables.size();
+        frame.chunkRecords = std::max<uint32_t>( 1,
+                    LOG_FILE_CHUNK_BYTES / (frame.recordSize * sizeof(double)) );
+        frame.reserved = 0;
+        mFile.write( (const char*)&frame, sizeof(frame) );
+
+        for (unsigned int j = 0; j < variables.size(); ++j)
+        {
+            const std::string name = variables[j]->name();
+            uint32_t values[4];
+            values[0] = name.size();
+            mFile.write( (const char*)values, sizeof(uint32_t) );
+            mFile.write( name.c_str(), values[0] );
+
+            values[1] = variables[j]->row();
+            values[2] = variables[j]->col();
+            values[3] = variables[j]->type();
+            mFile.write( (const char*)&values[1], 3 * sizeof(uint32_t) );
+        }
+
+        mChunks[i].header.frame = i;
+        mChunks[i].header.count = 0;
+        mChunks[i].capacity = frame.chunkRecords;
+        mChunks[i].records.reserve( frame.chunkRecords * frame.recordSize );
+    }
+    mFile.flush();
+    mFileOffset = mFile.tellp();
+    mIndex.clear();
+    mCompression = mDataRepository->logCompression();
+
+    mDropped = 0;
+    mClosing = false;
+    mDataRepository->setLogStreamLag( 0 );
+    mDataRepository->setLogStreamDropped( 0 );
+
+    return mFile.good();
+}
+
+void LogStreamer::close()
+{
+    if ( !mFile.is_open() )
+        return;
+
+    requestPeriodicTaskTermination();
+    join();
+
+    mClosing = true;
+    drain();
+    for (unsigned int i = 0; i < mChunks.size(); ++i)
+    {
+        writeChunk( i );
+    }
+
+    // Time index, so that readers open the file without scanning it.
+    LogFileFooter footer;
+    footer.indexOffset = mFileOffset;
+    footer.entryCount = mIndex.size();
+    std::memcpy( footer.magic, "ZIDX", 4 );
+    footer.reserved = 0;
+    mFile.write( (const char*)mIndex.data(), mIndex.size() * sizeof(LogFileIndexEntry) );
+    mFile.write( (const char*)&footer, sizeof(footer) );
+
+    mFile.close();
+    mChunks.clear();
+}
+
+void LogStreamer::run()
+{
+    drain();
+}
+
+void LogStreamer::drain()
+{
+    const LogFrameList& frames = mDataRepository->logFrames();
+    const std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+
+    double lag = 0;
+    for (unsigned int i = 0; i < frames.size(); ++i)
+    {
+        lag = std::max( lag, drainFrame(i, frames[i]) );
+
+        if ( mChunks[i].header.count && now - mChunks[i].opened > MAX_CHUNK_AGE )
+            writeChunk( i );
+    }
+    mFile.flush();
+
+    mDataRepository->setLogStreamLag( lag );
+    mDataRepository->setLogStreamDropped( mDropped );
+}
+
+double LogStreamer::drainFrame( unsigned int pIndex, LogFrame* pFrame )
+{
+    uint64_t write = pFrame->writeSequence();
+    uint64_t read = pFrame->readSequence();
+    if ( read >= write )
+        return 0;
+
+    const uint64_t capacity = pFrame->heapCapacity();
+    const uint64_t first = write - std::min(write, capacity);
+
+    // A triggered heap is written once it is frozen, or when the loop
+    // stopped while its post-trigger window was being written. Records
+    // that rolled out of its pre-trigger buffer were never meant to be kept.
+    if ( pFrame->isTriggered() )
+    {
+        const int state = pFrame->triggerState();
+        if ( state == LogTrigger::TRIGGER_ARMED ||
+             (state == LogTrigger::TRIGGER_FIRED && !mClosing) )
+            return 0;
+
+        write = pFrame->writeSequence();
+        read = std::max( read, write - std::min(write, capacity) );
+    }
+
+    // A frozen heap is not behind the loop.
+    const double lag = pFrame->isTriggered() ? 0 : (write - read) / pFrame->frequency();
+
+    // Records older than the heap capacity are gone already.
+    if ( read < first )
+    {
+        mDropped += first - read;
+        read = first;
+    }
+
+    const unsigned int recordSize = pFrame->recordSize();
+    mStaging.resize( (write - read) * recordSize );
+
+    // Copy up to the end of the heap, then from its beginning.
+    double* dest = mStaging.data();
+    for (uint64_t sequence = read; sequence < write; )
+    {
+        uint64_t count = std::min( write - sequence,
+                                   capacity - sequence % capacity );
+        std::memcpy( dest, pFrame->recordBySequence(sequence),
+                     count * recordSize * sizeof(double) );
+        dest += count * recordSize;
+        sequence += count;
+    }
+
+    // A ring heap may have overwritten the oldest records during the copy.
+    // The slot of a sequence is rewritten only once the writer reaches
+    // sequence + capacity.
+    uint64_t overwritten = 0;
+    if ( pFrame->isRingBuffer() && !pFrame->isTriggered() )
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t current = pFrame->writeSequence();
+        if ( current >= read + capacity )
+        {
+            overwritten = std::min( write, current - capacity + 1 ) - read;
+            mDropped += overwritten;
+        }
+    }
+
+    appendRecords( pIndex, read + overwritten,
+                   mStaging.data() + overwritten * recordSize,
+                   write - read - overwritten );
+
+    pFrame->setReadSequence( write );
+
+    return lag;
+}
+
+void LogStreamer::appendRecords( unsigned int pIndex, uint64_t pSequence,
+                                 const double* pRecords, uint64_t pCount )
+{
+    Chunk& chunk = mChunks[pIndex];
+    const unsigned int recordSize = mDataRepository->logFrames()[pIndex]->recordSize();
+
+    // Records of a chunk have consecutive sequence numbers.
+    if ( chunk.header.count &&
+         chunk.header.firstSequence + chunk.header.count != pSequence )
+        writeChunk( pIndex );
+
+    while ( pCount )
+    {
+        if ( chunk.header.count == 0 )
+        {
+            chunk.header.firstSequence = pSequence;
+            chunk.opened = std::chrono::steady_clock::now();
+        }
+
+        uint64_t count = std::min<uint64_t>( pCount, chunk.capacity - chunk.header.count );
+        chunk.records.insert( chunk.records.end(), pRecords,
+                              pRecords + count * recordSize );
+        chunk.header.count += count;
+
+        pRecords += count * recordSize;
+        pSequence += count;
+        pCount -= count;
+
+        if ( chunk.header.count == chunk.capacity )
+            writeChunk( pIndex );
+    }
+}
+
+void LogStreamer::writeChunk( unsigned int pIndex )
+{
+    Chunk& chunk = mChunks[pIndex];
+    if ( chunk.header.count == 0 )
+        return;
+
+    const size_t recordSize = chunk.records.size() / chunk.header.count;
+    chunk.header.firstTime = chunk.records.front();
+    chunk.header.lastTime = chunk.records[ (chunk.header.count - 1) * recordSize ];
+
+    const char* data = (const char*)chunk.records.data();
+    chunk.header.encoding = LOG_FILE_RAW;
+    chunk.header.bytes = chunk.records.size() * sizeof(double);
+    if ( mCompression )
+    {
+        mEncoded.clear();
+        LogCodec::encode( chunk.records.data(), chunk.header.count, recordSize, mEncoded );
+        if ( mEncoded.size() < chunk.header.bytes )
+        {
+            data = (const char*)mEncoded.data();
+            chunk.header.encoding = LOG_FILE_COMPRESSED;
+            chunk.header.bytes = mEncoded.size();
+        }
+    }
+
+    LogFileIndexEntry entry;
+    entry.chunk = chunk.header;
+    entry.offset = mFileOffset;
+    mIndex.push_back( entry );
+
+    mFile.write( (const char*)&chunk.header, sizeof(LogFileChunk) );
+    mFile.write( data, chunk.header.bytes );
+    mFileOffset += sizeof(LogFileChunk) + chunk.header.bytes;
+
+    chunk.header.count = 0;
+    chunk.records.clear();
+}
@@ -0,0 +1,100 @@
+/*
+ * LogStreamer.h
+ *
+ *  Drains the log heaps into a file while the loop runs.
+ */
+
+#ifndef LOG_STREAMER_H_
+#define LOG_STREAMER_H_
+
+#include <TaskXn.h>
+#include <logfile.h>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+class DataRepository;
+class LogFrame;
+
+/**
+ * Non real-time task that copies new log records from the log heaps to
+ * disk. The loop task never touches the file; the streamer follows each
+ * heap with its readSequence and appends the records to the chunk of the
+ * frame. Full chunks are written with one sequential write each, see
+ * logfile.h for the layout. If log compression is enabled the chunks are
+ * compressed with LogCodec before they are written. Triggered heaps are
+ * written once their capture is complete.
+ *
+ * How far behind the writer is (in seconds) and how many records were
+ * overwritten in a ring heap before they could be written are published
+ * in the main control heap.
+ */
+class LogStreamer : public TaskXn
+{
+public:
+    LogStreamer( DataRepository* pDataRepository,
+                 std::chrono::duration<double> period,
+                 std::string name );
+
+    /**
+     * Creates the log file and writes its header. Must be called after
+     * the log heap is bound and before runTask().
+     * @return false if the file could not be created
+     */
+    bool open( const std::string& pFileName );
+
+    /**
+     * Writes the records left in the heaps, the open chunks and the
+     * time index, then closes the file.
+     */
+    void close();
+
+private:
+    /** Chunk of a frame that is being filled */
+    struct Chunk
+    {
+        LogFileChunk header;
+        uint32_t capacity;          // records
+        std::vector<double> records;
+        std::chrono::steady_clock::time_point opened;
+    };
+
+    void run() override;
+
+    /** Copies the new records of all frames to disk. */
+    void drain();
+
+    /**
+     * Copies the records of pFrame in [readSequence, writeSequence) to
+     * its chunk.
+     * @return backlog of the frame in seconds
+     */
+    double drainFrame( unsigned int pIndex, LogFrame* pFrame );
+
+    /** Appends pCount records starting at pSequence to the chunk. */
+    void appendRecords( unsigned int pIndex, uint64_t pSequence,
+                        const double* pRecords, uint64_t pCount );
+
+    /** Writes the chunk to the file and starts an empty one. */
+    void writeChunk( unsigned int pIndex );
+
+    DataRepository* mDataRepository;
+    std::ofstream mFile;
+    uint64_t mFileOffset;
+
+    std::vector<Chunk> mChunks;
+    std::vector<LogFileIndexEntry> mIndex;
+
+    /** Records copied from a heap, validated before they reach a chunk */
+    std::vector<double> mStaging;
+
+    bool mCompression;
+    std::vector<uint8_t> mEncoded;
+
+    uint64_t mDropped;
+
+    /** Set for the last drain, after the loop has stopped */
+    bool mClosing;
+};
+
+#endif /* LOG_STREAMER_H_ */
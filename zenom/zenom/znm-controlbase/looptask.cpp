@@ -15,6 +15,7 @@ LoopTask::LoopTask( ControlBase* pControlBase
                     ,std::string name)
     : TaskXn(name, period,TaskXn::maxPriority())
     , mControlBase(pControlBase)
+    , mTick(0)
 
 {
 }
@@ -48,7 +49,11 @@ void LoopTask::run()
                 std::cerr << "An unknown exception occured in the doloop()"
                              " function." << std::endl;
             }
-            mControlBase->logVariables( elapsedTimeSec() );
+            mControlBase->logVariables( mTick, elapsedTimeSec() );
+        }
+        else
+        {
+            mControlBase->releaseMainHeap();
         }
 
         if( elapsedTimeSec() > mControlBase->duration() || error )
@@ -58,4 +63,6 @@ void LoopTask::run()
         }
     }
 
+    ++mTick;
+
 }
@@ -9,6 +9,7 @@
 #define LOOP_TASK_H_
 
 #include <TaskXn.h>
+#include <cstdint>
 
 
 class ControlBase;
@@ -24,6 +25,9 @@ private:
     ControlBase* mControlBase;
     void run() override;
 
+    /** Number of periods since the task started, paused ones included */
+    uint64_t mTick;
+
 };
 
 #endif /* LOOP_TASK_H_ */
@@ -22,11 +22,13 @@ DEFINES += ZNMCONTROLBASE_LIBRARY
 
 SOURCES += controlbase.cpp \
     lifecycletask.cpp \
-    looptask.cpp
+    looptask.cpp \
+    logstreamer.cpp
 
 HEADERS += controlbase.h\
     lifecycletask.h \
-    looptask.h
+    looptask.h \
+    logstreamer.h
 
 # Zenom Core Library
 INCLUDEPATH += ../znm-core
@@ -0,0 +1,47 @@
+/*
+ * ControlSpan.h
+ *
+ *  Values of a control variable read in place from the main control heap.
+ */
+
+#ifndef CONTROLSPAN_H_
+#define CONTROLSPAN_H_
+
+#include "controlvariable.h"
+
+/**
+ * ControlBase::registerControlSpan() ile kaydedilen control degiskeninin
+ * degerlerine salt okunur erisim. Degerler her dongude kopyalanmaz;
+ * doloop() main control heap'te GUI'nin son yayinladigi tamponu okur.
+ * Tampon bir dongu boyunca degismez.
+ *
+ * Baslangic degerleri kayit sirasinda verilir. Daha sonra degerleri
+ * yalnizca GUI degistirir; dongu tampona yazarsa GUI'nin commit'i ile
+ * cakisir ve tutarli goruntu bozulur.
+ */
+class ControlSpan
+{
+public:
+    ControlSpan() : mVariable(NULL) {}
+
+    explicit ControlSpan( ControlVariable* pVariable ) : mVariable(pVariable) {}
+
+    /** Degerlerin satir satir guncel adresi, dongu icinde gecerlidir */
+    const double* data() const { return mVariable->data(); }
+
+    unsigned int size() const { return mVariable->size(); }
+    unsigned int row() const { return mVariable->row(); }
+    unsigned int col() const { return mVariable->col(); }
+
+    double operator[]( unsigned int pIndex ) const { return data()[pIndex]; }
+
+    double operator()( unsigned int pRow, unsigned int pCol ) const
+    {
+        return data()[pRow * col() + pCol];
+    }
+
+private:
+    ControlVariable* mVariable;
+};
+
+#endif /* CONTROLSPAN_H_ */
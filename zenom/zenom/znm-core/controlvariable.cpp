@@ -8,12 +8,32 @@
 #include "controlvariable.h"
 #include<iostream>
 
-ControlVariable::ControlVariable(double* pAddr, const std::string& pName,
+ControlVariable::ControlVariable(void* pAddr, const std::string& pName,
+                                 unsigned int pRow, unsigned int pCol,
+                                 const std::string& pDesc, VariableType pType)
+: Variable(pAddr, pName, pDesc, pRow, pCol, pType)
+{
+    mHeader = NULL;
+    mModified = NULL;
+    mMainHeapAddr[0] = NULL;
+    mMainHeapAddr[1] = NULL;
+    mStaged = false;
+    mInPlace = false;
+}
+
+ControlVariable::ControlVariable(const std::string& pName,
                                  unsigned int pRow, unsigned int pCol,
                                  const std::string& pDesc)
-: Variable(pAddr, pName, pDesc, pRow, pCol)
+: Variable(NULL, pName, pDesc, pRow, pCol)
+, mStorage(pRow * pCol, 0.0)
 {
-    mMainHeapAddr = NULL;
+    mVariableAddr = mStorage.data();
+    mHeader = NULL;
+    mModified = NULL;
+    mMainHeapAddr[0] = NULL;
+    mMainHeapAddr[1] = NULL;
+    mStaged = false;
+    mInPlace = true;
 }
 
 ControlVariable::~ControlVariable()
@@ -21,38 +41,117 @@ ControlVariable::~ControlVariable()
 
 }
 
-void ControlVariable::setMainHeapAddr(double *pHeapAddr)
+void ControlVariable::setMainHeapAddr(ControlBlockHeader* pHeader,
+                                      std::atomic<uint64_t>* pModified,
+                                      double* pBuffer0,
+                                      double* pBuffer1)
 {
-    mMainHeapAddr = pHeapAddr;
+    mHeader = pHeader;
+    mModified = pModified;
+    mMainHeapAddr[0] = pBuffer0;
+    mMainHeapAddr[1] = pBuffer1;
+    discardStaged();
 }
 
 double ControlVariable::heapElement(int pIndex)
 {
-    return mMainHeapAddr[pIndex];
+    if ( mStaged )
+        return mStage[pIndex];
+
+    return buffer( mHeader->generation.load(std::memory_order_acquire) )[pIndex];
 }
 
 void ControlVariable::setHeapElement(int pIndex, double pVal)
 {
-    mMainHeapAddr[pIndex] = pVal;
+    if ( !mStaged )
+    {
+        const double* current = buffer( mHeader->generation.load(std::memory_order_acquire) );
+        mStage.assign( current, current + size() );
+        mStaged = true;
+    }
+    mStage[pIndex] = pVal;
 }
 
 double ControlVariable::heapElement(int pRow, int pCol)
 {
-    return mMainHeapAddr[pRow * col() + pCol];
+    return heapElement( pRow * col() + pCol );
 }
 
 void ControlVariable::setHeapElement(int pRow, int pCol, double pVal)
 {
-    mMainHeapAddr[pRow * col() + pCol] = pVal;
+    setHeapElement( pRow * col() + pCol, pVal );
+}
+
+void ControlVariable::discardStaged()
+{
+    mStage.clear();
+    mStaged = false;
+}
+
+void ControlVariable::commitToHeap( uint64_t pGeneration )
+{
+    // Tampon iki commit oncesinin degerlerini tasir; yalnizca son
+    // commit'te degisen degiskenler guncel tampondan tasinir.
+    if ( mStaged )
+    {
+        memcpy( buffer(pGeneration), mStage.data(), sizeof(double) * size() );
+        mModified->store( pGeneration, std::memory_order_relaxed );
+        discardStaged();
+    }
+    else if ( mModified->load(std::memory_order_relaxed) == pGeneration - 1 )
+    {
+        memcpy( buffer(pGeneration), buffer(pGeneration - 1), sizeof(double) * size() );
+    }
 }
 
 void ControlVariable::copyToHeap()
 {
-    memcpy( mMainHeapAddr, mVariableAddr, sizeof(double) * size() );
+    if ( mType != VARIABLE_DOUBLE )
+    {
+        const char* element = (const char*)mVariableAddr;
+        for ( unsigned int i = 0; i < size(); ++i, element += variableTypeSize(mType) )
+        {
+            mMainHeapAddr[0][i] = variableElementToDouble( element, mType );
+        }
+        memcpy( mMainHeapAddr[1], mMainHeapAddr[0], sizeof(double) * size() );
+        return;
+    }
 
+    memcpy( mMainHeapAddr[0], mVariableAddr, sizeof(double) * size() );
+    memcpy( mMainHeapAddr[1], mVariableAddr, sizeof(double) * size() );
 }
 
-void ControlVariable::copyFromHeap()
+bool ControlVariable::copyFromHeap( uint64_t pGeneration, uint64_t pSince )
 {
-    memcpy( mVariableAddr, mMainHeapAddr, sizeof(double) * size() );
+    if ( mInPlace )
+    {
+        mVariableAddr = buffer(pGeneration);
+        return false;
+    }
+
+    if ( mModified->load(std::memory_order_relaxed) <= pSince )
+        return false;
+
+    if ( mType != VARIABLE_DOUBLE )
+    {
+        const double* values = buffer(pGeneration);
+        char* element = (char*)mVariableAddr;
+        for ( unsigned int i = 0; i < size(); ++i, element += variableTypeSize(mType) )
+        {
+            variableElementFromDouble( values[i], element, mType );
+        }
+        return true;
+    }
+
+    memcpy( mVariableAddr, buffer(pGeneration), sizeof(double) * size() );
+    return true;
+}
+
+void ControlVariable::detachFromHeap()
+{
+    if ( !mInPlace || mVariableAddr == mStorage.data() )
+        return;
+
+    memcpy( mStorage.data(), mVariableAddr, sizeof(double) * size() );
+    mVariableAddr = mStorage.data();
 }
@@ -10,31 +10,134 @@
 
 #include "variable.h"
 #include <string.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Control degiskenleri main control heap'te iki tampon halinde tutulur.
+ * GUI degisiklikleri guncel olmayan tampona yazar ve generation'i
+ * artirarak hepsini ayni anda yayinlar; guncel tampon generation & 1'dir.
+ * Basligi, degisken basina son degistigi generation ve iki tampon izler.
+ */
+struct ControlBlockHeader
+{
+    /** Yayinlanan son commit */
+    std::atomic<uint64_t> generation;
+
+    /** Yazilmakta olan commit, okuyucular kopyalarini buna gore dogrular */
+    std::atomic<uint64_t> pending;
+
+    /**
+     * Control process'in degiskenlerini yerinde okudugu commit ya da
+     * NOT_READING. GUI bu commit'in tamponuna yazmaz.
+     */
+    std::atomic<uint64_t> reading;
+
+    static const uint64_t NOT_READING = ~(uint64_t)0;
+};
 
 class ControlVariable: public Variable
 {
 public:
-    ControlVariable(double* pAddr,
+    /**
+     * Heap'te degerler tipten bagimsiz olarak double tutulur; double
+     * olmayan degiskenler kopyalanirken cevrilir.
+     */
+    ControlVariable(void* pAddr,
                     const std::string& pName,
                     unsigned int pRow = 1,
                     unsigned int pCol = 1,
+                    const std::string& pDesc = "",
+                    VariableType pType = VARIABLE_DOUBLE);
+
+    /**
+     * Degerleri main control heap'te yerinde okunan degisken. Heap'e
+     * baglanana kadar degerler degiskenin kendi belleginde tutulur.
+     */
+    ControlVariable(const std::string& pName,
+                    unsigned int pRow,
+                    unsigned int pCol,
                     const std::string& pDesc = "");
 
     virtual ~ControlVariable();
 
-    void setMainHeapAddr( double* pHeapAddr );
+    /** Yerinde okunan (double) degiskenin degerlerinin guncel adresi */
+    double* data() { return (double*)mVariableAddr; }
+
+    /** Degerler heap'te yerinde okunuyor ise true */
+    bool isInPlace() { return mInPlace; }
+
+    /**
+     * @param pHeader control block basligi
+     * @param pModified degiskenin son degistigi generation
+     * @param pBuffer0 degiskenin 0. tampondaki adresi
+     * @param pBuffer1 degiskenin 1. tampondaki adresi
+     */
+    void setMainHeapAddr( ControlBlockHeader* pHeader,
+                          std::atomic<uint64_t>* pModified,
+                          double* pBuffer0,
+                          double* pBuffer1 );
 
+    /**
+     * Elemanin degerini dondurur. Commit edilmemis bir deger varsa o,
+     * yoksa yayinlanan deger okunur.
+     */
     double heapElement(int pIndex);
+
+    /**
+     * Elemani degistirir. Deger DataRepository::commitControlVariables()
+     * cagrilana kadar control process'e gorunmez.
+     */
     void setHeapElement(int pIndex, double pVal);
 
     double heapElement(int pRow, int pCol);
     void setHeapElement(int pRow, int pCol, double pVal);
 
+    /** Commit edilmemis deger varsa true */
+    bool isStaged() { return mStaged; }
+
+    /** Commit edilmemis degerleri atar */
+    void discardStaged();
+
+    /**
+     * GUI tarafindan pGeneration commit'i sirasinda cagrilir. Degiskeni
+     * pGeneration'in tamponuna yazar: commit edilmemis degerler varsa
+     * onlari, onceki commit'te degisti ise guncel tampondakileri.
+     */
+    void commitToHeap( uint64_t pGeneration );
+
+    /** Degiskenin degerini iki tampona da yazar. */
     void copyToHeap();
-    void copyFromHeap();
+
+    /**
+     * Degisken pSince'ten sonra degisti ise pGeneration'in tamponundan
+     * okur. Yerinde okunan degisken kopyalanmaz, pGeneration'in
+     * tamponunu gosterir.
+     * @return kopyalama yapildi ise true
+     */
+    bool copyFromHeap( uint64_t pGeneration, uint64_t pSince );
+
+    /**
+     * Yerinde okunan degiskenin guncel degerlerini kendi bellegine alir;
+     * degisken heap'i birakir.
+     */
+    void detachFromHeap();
 
 private:
-    double* mMainHeapAddr;
+    double* buffer( uint64_t pGeneration ) { return mMainHeapAddr[pGeneration & 1]; }
+
+    ControlBlockHeader* mHeader;
+    std::atomic<uint64_t>* mModified;
+    double* mMainHeapAddr[2];
+
+    /** Commit edilmemis degerler, GUI tarafinda kullanilir */
+    std::vector<double> mStage;
+    bool mStaged;
+
+    /** Yerinde okunan degiskenin heap disindaki bellegi */
+    std::vector<double> mStorage;
+    bool mInPlace;
 };
 
 #endif /* CONTROLVARIABLE_H_ */
@@ -1,7 +1,8 @@
 #include "datarepository.h"
-#include <fstream>
+#include <cstring>
 #include <iostream>
 #include <system_error>
+#include <algorithm>
 
 DataRepository* DataRepository::mInstance = NULL;
 
@@ -16,7 +17,18 @@ DataRepository* DataRepository::instance()
 }
 
 DataRepository::DataRepository()
-    : mMainControlHeap(nullptr)
+    : mFrameLogging(true)
+    , mControlGeneration(0)
+    , mControlInPlace(false)
+    , mControlHeld(false)
+    , mLogRingCapacity(0)
+    , mLogHeapGeneration(0)
+    , mMainControlHeap(nullptr)
+    , mLogHeap(nullptr)
+    , mLogHeapAddr(nullptr)
+    , mLogHeapUsers(0)
+    , mLogHeapReleaseRequested(false)
+    , mSchema(nullptr)
     , mSender(nullptr)
     , mReceiver(nullptr)
 {
@@ -35,13 +47,18 @@ void DataRepository::setProjectName(const std::string &pName)
 // Zenom process creates
 void DataRepository::createMainControlHeap()
 {
-    // frequency, duration, current time, overrun
-    int size = 4;
+    // frequency, duration, current time, overrun,
+    // log streaming, log stream lag, log stream dropped, log compression
+    int size = MAIN_HEAP_GLOBALS;
 
     // Control Variables
+    // control block header, generation of last change of each variable
+    // and two buffers of values
+    size += sizeof(ControlBlockHeader) / sizeof(double);
+    size += mControlVariables.size();
     for (unsigned int i = 0; i < mControlVariables.size(); ++i)
     {
-        size += mControlVariables[i]->size();
+        size += 2 * mControlVariables[i]->size();
     }
 
     // Log Variables
@@ -57,7 +74,19 @@ void DataRepository::createMainControlHeap()
     setDuration( 10 );
     setElapsedTimeSecond( 0 );
     setOverruns( 0 );
-
+    setLogStreaming( false );
+    setLogStreamLag( 0 );
+    setLogStreamDropped( 0 );
+    setLogCompression( false );
+
+    ControlBlockHeader* header = controlBlockHeader();
+    header->generation.store( 0 );
+    header->pending.store( 0 );
+    header->reading.store( ControlBlockHeader::NOT_READING );
+    for (unsigned int i = 0; i < mControlVariables.size(); ++i)
+    {
+        controlBlockModified()[i].store( 0 );
+    }
 
     assignHeapAddressToVariables();
 
@@ -79,17 +108,37 @@ void DataRepository::bindMainControlHeap()
     mMainControlHeapAddr = (double*)mMainControlHeap->ptrToShMem();
 
     assignHeapAddressToVariables();
+    mControlGeneration = controlBlockHeader()->generation.load( std::memory_order_acquire );
+    mControlHeld = false;
+    mControlInPlace = false;
+    for (unsigned int i = 0; i < mControlVariables.size(); ++i)
+    {
+        mControlInPlace = mControlInPlace || mControlVariables[i]->isInPlace();
+    }
 }
 
 void DataRepository::assignHeapAddressToVariables()
 {
-    int size = 4;
+    int size = MAIN_HEAP_GLOBALS;
     // Control Variables Address
+    size += sizeof(ControlBlockHeader) / sizeof(double);
+    size += mControlVariables.size();
+
+    int bufferSize = 0;
+    for (unsigned int i = 0; i < mControlVariables.size(); ++i)
+    {
+        bufferSize += mControlVariables[i]->size();
+    }
+
     for (unsigned int i = 0; i < mControlVariables.size(); ++i)
     {
-        mControlVariables[i]->setMainHeapAddr( &(mMainControlHeapAddr[size]) );
+        mControlVariables[i]->setMainHeapAddr( controlBlockHeader(),
+                                               &(controlBlockModified()[i]),
+                                               &(mMainControlHeapAddr[size]),
+                                               &(mMainControlHeapAddr[size + bufferSize]) );
         size += mControlVariables[i]->size();
     }
+    size += bufferSize;
 
     // Log Variables Address
     for (unsigned int i = 0; i < mLogVariables.size(); ++i)
@@ -99,6 +148,118 @@ void DataRepository::assignHeapAddressToVariables()
     }
 }
 
+ControlBlockHeader* DataRepository::controlBlockHeader()
+{
+    return (ControlBlockHeader*)&(mMainControlHeapAddr[MAIN_HEAP_GLOBALS]);
+}
+
+std::atomic<uint64_t>* DataRepository::controlBlockModified()
+{
+    return (std::atomic<uint64_t>*)( controlBlockHeader() + 1 );
+}
+
+bool DataRepository::commitControlVariables()
+{
+    bool staged = false;
+    for (unsigned int i = 0; i < mControlVariables.size() && !staged; ++i)
+    {
+        staged = mControlVariables[i]->isStaged();
+    }
+    if ( !staged )
+        return true;
+
+    // Tek yazar GUI'dir. Yeni commit guncel olmayan tampona yazilir;
+    // bu tamponu okumakta olan control process pending'e bakarak
+    // kopyasini tekrarlar.
+    ControlBlockHeader* header = controlBlockHeader();
+    const uint64_t generation = header->generation.load( std::memory_order_relaxed ) + 1;
+    header->pending.store( generation );
+
+    // Control process tamponu hala yerinde okuyor ise commit ertelenir.
+    // pending ve reading sirali (seq_cst) erisilir; iki taraftan en az
+    // biri digerinin yazdigini gorur.
+    const uint64_t reading = header->reading.load();
+    if ( reading != ControlBlockHeader::NOT_READING && reading + 1 != generation )
+    {
+        header->pending.store( generation - 1 );
+        return false;
+    }
+    std::atomic_thread_fence( std::memory_order_release );
+
+    for (unsigned int i = 0; i < mControlVariables.size(); ++i)
+    {
+        mControlVariables[i]->commitToHeap( generation );
+    }
+
+    header->generation.store( generation, std::memory_order_release );
+    return true;
+}
+
+void DataRepository::discardControlVariables()
+{
+    for (unsigned int i = 0; i < mControlVariables.size(); ++i)
+    {
+        mControlVariables[i]->discardStaged();
+    }
+}
+
+bool DataRepository::updateControlVariables()
+{
+    ControlBlockHeader* header = controlBlockHeader();
+    uint64_t generation = header->generation.load( std::memory_order_acquire );
+    if ( generation == mControlGeneration && (mControlHeld || !mControlInPlace) )
+        return false;
+
+    for (;;)
+    {
+        if ( mControlInPlace )
+        {
+            // Tampon GUI'ye kapatilir; kapatmadan once baslamis bir
+            // commit varsa onun yayinlanmasi beklenir.
+            header->reading.store( generation );
+            if ( header->pending.load() >= generation + 2 )
+            {
+                generation = header->generation.load( std::memory_order_acquire );
+                continue;
+            }
+        }
+
+        for (unsigned int i = 0; i < mControlVariables.size(); ++i)
+        {
+            mControlVariables[i]->copyFromHeap( generation, mControlGeneration );
+        }
+
+        if ( mControlInPlace )
+            break;
+
+        // Ayni tampona yazan bir sonraki commit basladi ise kopya tutarli
+        // olmayabilir; yeni generation ile tekrarlanir.
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if ( header->pending.load( std::memory_order_relaxed ) < generation + 2 )
+            break;
+
+        generation = header->generation.load( std::memory_order_acquire );
+    }
+
+    mControlGeneration = generation;
+    mControlHeld = mControlInPlace;
+    return true;
+}
+
+void DataRepository::releaseControlVariables()
+{
+    if ( !mControlHeld )
+        return;
+
+    for (unsigned int i = 0; i < mControlVariables.size(); ++i)
+    {
+        mControlVariables[i]->detachFromHeap();
+    }
+
+    controlBlockHeader()->reading.store( ControlBlockHeader::NOT_READING );
+    mControlHeld = false;
+}
+
 void DataRepository::unbindMainControlHeap()
 {
     if(mMainControlHeap != nullptr){
@@ -107,29 +268,85 @@ void DataRepository::unbindMainControlHeap()
     }
 }
 
+void DataRepository::setLogRingCapacity(unsigned int pCapacity)
+{
+    mLogRingCapacity = pCapacity;
+    for (unsigned int i = 0; i < mLogVariables.size(); ++i)
+    {
+        mLogVariables[i]->setRingCapacity( pCapacity );
+    }
+}
+
+const LogFrameList& DataRepository::logFrames()
+{
+    return mLogFrames;
+}
+
+// Zenom process creates
 void DataRepository::createLogVariablesHeap()
 {
-    try
+    deleteLogVariablesHeap();
+    ++mLogHeapGeneration;
+
+    // Group log variables into frames.
+    std::vector<LogFrame*> variableFrames( mLogVariables.size() );
+    for (unsigned int i = 0; i < mLogVariables.size(); ++i)
     {
-        for (unsigned int i = 0; i < mLogVariables.size(); ++i)
+        LogVariable* logVariable = mLogVariables[i];
+        LogFrame* frame = nullptr;
+        for (unsigned int j = 0; mFrameLogging && j < mLogFrames.size(); ++j)
         {
-            mLogVariables[i]->createHeap();
+            if ( mLogFrames[j]->frequency() == logVariable->frequency() &&
+                 mLogFrames[j]->startTime() == logVariable->startTime() &&
+                 mLogFrames[j]->duration() == logVariable->duration() &&
+                 mLogFrames[j]->ringCapacity() == logVariable->ringCapacity() &&
+                 mLogFrames[j]->trigger() == logVariable->trigger() )
+            {
+                frame = mLogFrames[j];
+                break;
+            }
         }
+
+        if ( !frame )
+        {
+            frame = new LogFrame();
+            mLogFrames.push_back( frame );
+        }
+        frame->addLogVariable( logVariable );
+        variableFrames[i] = frame;
     }
-    catch( std::system_error e )
-    {
-        std::cout << std::string(e.what()) << std::endl;
 
+    // Heaps are cache line aligned so that two frames never share a line.
+    const size_t alignment = 64;
+    std::vector<uint64_t> frameOffsets( mLogFrames.size() );
+    size_t size = sizeof(LogArenaHeader) + mLogVariables.size() * sizeof(uint64_t);
+    for (unsigned int i = 0; i < mLogFrames.size(); ++i)
+    {
+        size = (size + alignment - 1) / alignment * alignment;
+        frameOffsets[i] = size;
+        size += mLogFrames[i]->heapByteSize();
     }
-}
 
-void DataRepository::deleteLogVariablesHeap()
-{
     try
     {
+        mLogHeap = new SharedMem( mProjectName + "LogHeap", size );
+        mLogHeapAddr = (char*)mLogHeap->ptrToShMem();
+
+        LogArenaHeader* header = (LogArenaHeader*)mLogHeapAddr;
+        header->size = size;
+        header->count = mLogVariables.size();
+
+        uint64_t* offsets = logArenaOffsets();
         for (unsigned int i = 0; i < mLogVariables.size(); ++i)
         {
-            mLogVariables[i]->deleteHeap();
+            size_t frame = std::find( mLogFrames.begin(), mLogFrames.end(),
+                                      variableFrames[i] ) - mLogFrames.begin();
+            offsets[i] = frameOffsets[frame];
+        }
+
+        for (unsigned int i = 0; i < mLogFrames.size(); ++i)
+        {
+            mLogFrames[i]->createHeap( mLogHeapAddr + frameOffsets[i] );
         }
     }
     catch( std::system_error e )
@@ -139,14 +356,84 @@ void DataRepository::deleteLogVariablesHeap()
     }
 }
 
+void DataRepository::deleteLogVariablesHeap()
+{
+    // Export'lar iptal edilir ve heap'i birakmalari beklenir.
+    std::unique_lock<std::mutex> lock( mLogHeapMutex );
+    mLogHeapReleaseRequested = true;
+    mLogHeapReleased.wait( lock, [this]{ return mLogHeapUsers == 0; } );
+    mLogHeapReleaseRequested = false;
+
+    clearLogFrames();
+
+    if(mLogHeap != nullptr){
+        delete mLogHeap;
+        mLogHeap = nullptr;
+        mLogHeapAddr = nullptr;
+    }
+}
+
+bool DataRepository::acquireLogHeap()
+{
+    std::lock_guard<std::mutex> lock( mLogHeapMutex );
+    if ( mLogHeap == nullptr )
+        return false;
+
+    ++mLogHeapUsers;
+    return true;
+}
+
+void DataRepository::releaseLogHeap()
+{
+    std::lock_guard<std::mutex> lock( mLogHeapMutex );
+    --mLogHeapUsers;
+    mLogHeapReleased.notify_all();
+}
+
+// Control base process binds
 void DataRepository::bindLogVariablesHeap()
 {
     try
     {
+        mLogHeap = new SharedMem( mProjectName + "LogHeap" );
+        mLogHeapAddr = (char*)mLogHeap->ptrToShMem();
+
+        LogArenaHeader* header = (LogArenaHeader*)mLogHeapAddr;
+        if ( header->count != mLogVariables.size() )
+        {
+            std::cerr << "Log heap does not match the registered log variables"
+                      << std::endl;
+            unbindLogVariableHeap();
+            return;
+        }
+
+        // Rebuild the frames of the GUI from the offset table.
+        uint64_t* offsets = logArenaOffsets();
+        std::vector<uint64_t> frameOffsets;
         for (unsigned int i = 0; i < mLogVariables.size(); ++i)
         {
-            mLogVariables[i]->bindHeap();
+            size_t frame = std::find( frameOffsets.begin(), frameOffsets.end(),
+                                      offsets[i] ) - frameOffsets.begin();
+            if ( frame == frameOffsets.size() )
+            {
+                frameOffsets.push_back( offsets[i] );
+                mLogFrames.push_back( new LogFrame() );
+            }
+            mLogFrames[frame]->addLogVariable( mLogVariables[i] );
+        }
+
+        for (unsigned int i = 0; i < mLogFrames.size(); ++i)
+        {
+            mLogFrames[i]->bindHeap( mLogHeapAddr + frameOffsets[i] );
+            if ( !mLogFrames[i]->bindTriggerSource( mLogVariables ) )
+            {
+                std::cerr << "Invalid trigger source for log variable "
+                          << mLogFrames[i]->logVariables().front()->name()
+                          << ", the trigger is ignored" << std::endl;
+            }
         }
+
+        mLogScheduler.build( mLogFrames, frequency() );
     }
     catch( std::system_error e )
     {
@@ -157,18 +444,34 @@ void DataRepository::bindLogVariablesHeap()
 
 void DataRepository::unbindLogVariableHeap()
 {
-    try
-    {
-        for (unsigned int i = 0; i < mLogVariables.size(); ++i)
-        {
-            mLogVariables[i]->unbindHeap();
-        }
+    clearLogFrames();
+
+    if(mLogHeap != nullptr){
+        delete mLogHeap;
+        mLogHeap = nullptr;
+        mLogHeapAddr = nullptr;
     }
-    catch( std::system_error e )
+}
+
+void DataRepository::clearLogFrames()
+{
+    mLogScheduler.clear();
+
+    for (unsigned int i = 0; i < mLogVariables.size(); ++i)
     {
-        std::cout << std::string(e.what()) << std::endl;
+        mLogVariables[i]->setFrame( nullptr, 0 );
+    }
 
+    for (unsigned int i = 0; i < mLogFrames.size(); ++i)
+    {
+        delete mLogFrames[i];
     }
+    mLogFrames.clear();
+}
+
+uint64_t* DataRepository::logArenaOffsets()
+{
+    return (uint64_t*)(mLogHeapAddr + sizeof(LogArenaHeader));
 }
 
 void DataRepository::createMessageQueues()
@@ -221,22 +524,24 @@ void DataRepository::sendStateRequest(StateRequest pRequest)
     mSender->send(&pRequest, sizeof(StateRequest) );
 }
 
-ssize_t DataRepository::readState(StateRequest* pState)
+ssize_t DataRepository::readState(StateRequest* pState, int pTimeoutMs)
 {
-    // timeout 1 seconds
+    // mq_timedreceive mutlak CLOCK_REALTIME zamani bekler.
     struct timespec to;
-    to.tv_nsec = 0;
-    to.tv_sec = 1;
+    clock_gettime( CLOCK_REALTIME, &to );
+    to.tv_sec += pTimeoutMs / 1000;
+    to.tv_nsec += (pTimeoutMs % 1000) * 1000000L;
+    if ( to.tv_nsec >= 1000000000L )
+    {
+        to.tv_sec += 1;
+        to.tv_nsec -= 1000000000L;
+    }
     return mReceiver->receive( pState, sizeof(StateRequest), &to );
 }
 
-void DataRepository::sampleLogVariable(double pSimTimeInSec)
+void DataRepository::sampleLogVariable(uint64_t pTick, double pSimTimeInSec)
 {
-
-    for (unsigned int i = 0; i < mLogVariables.size(); ++i)
-    {
-        mLogVariables[i]->insertToHeap( pSimTimeInSec, frequency() );
-    }
+    mLogScheduler.sample( pTick, pSimTimeInSec );
 }
 
 void DataRepository::insertLogVariable(LogVariable *pLogVariable)
@@ -272,83 +577,207 @@ const ControlVariableList &DataRepository::controlVariables()
     return mControlVariables;
 }
 
-void DataRepository::writeVariablesToFile()
+namespace
 {
-    std::ofstream file ("variables.txt");
-    if ( !file.is_open() )
-        return;
+// Isim ve aciklamalar 8 byte'a tamamlanir, entry'ler hizali kalir.
+size_t schemaPadded(size_t pLength)
+{
+    return (pLength + 7) / 8 * 8;
+}
+}
 
-    ControlVariable* controlVariable;
-    file << mControlVariables.size() << std::endl;
+size_t DataRepository::schemaEntrySize(Variable* pVariable)
+{
+    return sizeof(SchemaEntry) + schemaPadded( pVariable->name().size() ) +
+            schemaPadded( pVariable->description().size() );
+}
+
+char* DataRepository::writeSchemaEntry(char* pAddr, Variable* pVariable)
+{
+    SchemaEntry* entry = (SchemaEntry*)pAddr;
+    entry->row = pVariable->row();
+    entry->col = pVariable->col();
+    entry->type = pVariable->type();
+    entry->nameLength = pVariable->name().size();
+    entry->descriptionLength = pVariable->description().size();
+    entry->reserved = 0;
+
+    pAddr += sizeof(SchemaEntry);
+    memcpy( pAddr, pVariable->name().data(), entry->nameLength );
+    pAddr += schemaPadded( entry->nameLength );
+    memcpy( pAddr, pVariable->description().data(), entry->descriptionLength );
+    return pAddr + schemaPadded( entry->descriptionLength );
+}
+
+const char* DataRepository::readSchemaEntry(const char* pAddr, const char* pEnd,
+                                            SchemaEntry* pEntry, std::string* pName,
+                                            std::string* pDesc)
+{
+    if ( pEnd - pAddr < (ptrdiff_t)sizeof(SchemaEntry) )
+        return nullptr;
+    memcpy( pEntry, pAddr, sizeof(SchemaEntry) );
+    pAddr += sizeof(SchemaEntry);
+
+    if ( pEntry->type > VARIABLE_BOOL || pEntry->row == 0 || pEntry->col == 0 ||
+         (size_t)(pEnd - pAddr) < schemaPadded( pEntry->nameLength ) )
+        return nullptr;
+    pName->assign( pAddr, pEntry->nameLength );
+    pAddr += schemaPadded( pEntry->nameLength );
+
+    if ( (size_t)(pEnd - pAddr) < schemaPadded( pEntry->descriptionLength ) )
+        return nullptr;
+    pDesc->assign( pAddr, pEntry->descriptionLength );
+    return pAddr + schemaPadded( pEntry->descriptionLength );
+}
+
+// Control base process creates
+void DataRepository::publishSchema()
+{
+    deleteSchema();
+
+    size_t size = sizeof(SchemaHeader);
     for (unsigned int i = 0; i < mControlVariables.size(); ++i)
     {
-        controlVariable = mControlVariables[i];
-        file << controlVariable->name() << std::endl;
-        file << controlVariable->row() << std::endl;
-        file << controlVariable->col() << std::endl;
-        file << controlVariable->description() << std::endl;
+        size += schemaEntrySize( mControlVariables[i] );
+    }
+    for (unsigned int i = 0; i < mLogVariables.size(); ++i)
+    {
+        size += schemaEntrySize( mLogVariables[i] );
     }
 
-    LogVariable* logVariable;
-    file << mLogVariables.size() << std::endl;
+    mSchema = new SharedMem( mProjectName + "Schema", size );
+    char* addr = (char*)mSchema->ptrToShMem();
+
+    SchemaHeader* header = (SchemaHeader*)addr;
+    header->version = SchemaHeader::VERSION;
+    header->reserved = 0;
+    header->size = size;
+    header->controlCount = mControlVariables.size();
+    header->logCount = mLogVariables.size();
+
+    addr += sizeof(SchemaHeader);
+    for (unsigned int i = 0; i < mControlVariables.size(); ++i)
+    {
+        addr = writeSchemaEntry( addr, mControlVariables[i] );
+    }
     for (unsigned int i = 0; i < mLogVariables.size(); ++i)
     {
-        logVariable = mLogVariables[i];
-        file << logVariable->name() << std::endl;
-        file << logVariable->row() << std::endl;
-        file << logVariable->col() << std::endl;
-        file << logVariable->description() << std::endl;
+        addr = writeSchemaEntry( addr, mLogVariables[i] );
     }
 
-    file.close();
+    header->magic.store( SchemaHeader::MAGIC, std::memory_order_release );
 }
 
-bool DataRepository::readVariablesFromFile()
+void DataRepository::deleteSchema()
 {
-    std::ifstream file ("variables.txt");
-    if ( !file.is_open() )
+    if(mSchema != nullptr){
+        delete mSchema;
+        mSchema = nullptr;
+    }
+}
+
+// Zenom process binds
+bool DataRepository::readSchema()
+{
+    SharedMem* schema;
+    try
+    {
+        schema = new SharedMem( mProjectName + "Schema", znm_tools::Flags::READ_ONLY );
+    }
+    catch( std::system_error e )
+    {
+        std::cerr << std::string(e.what()) << std::endl;
+        return false;
+    }
+
+    // Baslik okunmadan once blok en az baslik kadar olmali.
+    if ( schema->size() < sizeof(SchemaHeader) )
+    {
+        std::cerr << "Schema block is too small" << std::endl;
+        delete schema;
         return false;
+    }
 
-     std::string countString, name, desc, row, col;
-     unsigned int count;
+    const char* addr = (const char*)schema->ptrToShMem();
+    const SchemaHeader* header = (const SchemaHeader*)addr;
+    if ( header->magic.load( std::memory_order_acquire ) != SchemaHeader::MAGIC )
+    {
+        std::cerr << "Schema block magic mismatch" << std::endl;
+        delete schema;
+        return false;
+    }
 
-     getline( file, countString );
-     count = atoi( countString.c_str() );
+    if ( header->version != SchemaHeader::VERSION )
+    {
+        std::cerr << "Schema block version " << header->version
+                  << " is not supported" << std::endl;
+        delete schema;
+        return false;
+    }
 
-    for (unsigned int i = 0; i < count; ++i)
+    // header->size diger surecten gelir, eslenen boyutun disina tasamaz.
+    if ( header->size < sizeof(SchemaHeader) || header->size > schema->size() )
     {
-        getline( file, name );
-        getline( file, row );
-        getline( file, col );
-        getline( file, desc );
+        std::cerr << "Schema block size " << header->size
+                  << " does not match the mapping" << std::endl;
+        delete schema;
+        return false;
+    }
 
-        mControlVariables.push_back( new ControlVariable(NULL, name,
-                                atoi(row.c_str()), atoi(col.c_str()), desc) );
+    // Her kayit en az bir SchemaEntry tutar; sayilar da diger surecten
+    // gelir ve reserve() edilmeden once blogun boyutuyla sinirlanir.
+    const uint64_t maxEntries = (header->size - sizeof(SchemaHeader)) / sizeof(SchemaEntry);
+    if ( header->controlCount > maxEntries ||
+         header->logCount > maxEntries - header->controlCount )
+    {
+        std::cerr << "Schema block has " << header->controlCount << " control and "
+                  << header->logCount << " log variables, more than its size holds"
+                  << std::endl;
+        delete schema;
+        return false;
     }
 
-    getline( file, countString );
-    count = atoi( countString.c_str() );
+    const char* end = addr + header->size;
+    addr += sizeof(SchemaHeader);
 
-    for (unsigned int i = 0; i < count; ++i)
+    SchemaEntry entry;
+    std::string name, desc;
+    mControlVariables.reserve( header->controlCount );
+    for (uint64_t i = 0; addr && i < header->controlCount; ++i)
     {
-        getline( file, name );
-        getline( file, row );
-        getline( file, col );
-        getline( file, desc );
+        addr = readSchemaEntry( addr, end, &entry, &name, &desc );
+        if ( addr )
+            mControlVariables.push_back( new ControlVariable(NULL, name,
+                                        entry.row, entry.col, desc,
+                                        (VariableType)entry.type) );
+    }
 
-        mLogVariables.push_back( new LogVariable(NULL, name,
-                       atoi(row.c_str()), atoi(col.c_str()), desc) );
+    mLogVariables.reserve( header->logCount );
+    for (uint64_t i = 0; addr && i < header->logCount; ++i)
+    {
+        addr = readSchemaEntry( addr, end, &entry, &name, &desc );
+        if ( addr )
+            mLogVariables.push_back( new LogVariable(NULL, name,
+                                    entry.row, entry.col, desc,
+                                    (VariableType)entry.type) );
     }
 
-    file.close();
+    delete schema;
 
-    remove( "variables.txt" );
+    if ( !addr )
+    {
+        std::cerr << "Schema block is corrupt" << std::endl;
+        clear();
+        return false;
+    }
 
     return true;
 }
 
 void DataRepository::clear()
 {
+    clearLogFrames();
+
     for (unsigned int i = 0; i < mControlVariables.size(); ++i)
     {
         delete mControlVariables[i];
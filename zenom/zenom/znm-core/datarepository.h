@@ -3,12 +3,62 @@
 
 #include <vector>
 #include <logvariable.h>
+#include <logframe.h>
+#include <logscheduler.h>
 #include <controlvariable.h>
 #include <MsgQueue.h>
+#include <SharedMem.h>
 #include <iostream>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * All log heaps live in a single shared memory segment (the log arena).
+ * The header is followed by an offset table with one entry per log
+ * variable, in registration order: the byte offset of the LogFrame heap
+ * the variable is recorded in. Variables sharing an offset share a frame
+ * and take their columns in registration order. The frame heaps follow.
+ */
+struct LogArenaHeader
+{
+    uint64_t size;      // arena size in bytes
+    uint64_t count;     // number of entries in the offset table
+};
+
+/**
+ * The control process publishes the variable schema in a shared memory
+ * segment (the schema block) once, after initialize(). The header is
+ * followed by one SchemaEntry per control variable and then one per log
+ * variable, in registration order. Each entry is followed by its name
+ * and description, each padded to 8 bytes. magic is stored last, so a
+ * block with a valid magic is complete.
+ */
+struct SchemaHeader
+{
+    static const uint64_t MAGIC = 0x4d454843534d4e5aULL;    // "ZNMSCHEM"
+    static const uint32_t VERSION = 1;
+
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t size;          // block size in bytes
+    uint64_t controlCount;
+    uint64_t logCount;
+};
+
+struct SchemaEntry
+{
+    uint32_t row;
+    uint32_t col;
+    uint32_t type;          // VariableType
+    uint32_t nameLength;
+    uint32_t descriptionLength;
+    uint32_t reserved;
+};
 
 typedef std::vector<ControlVariable*> ControlVariableList;
 typedef std::vector<LogVariable*> LogVariableList;
+typedef std::vector<LogFrame*> LogFrameList;
 //singleton
 class DataRepository
 {
@@ -47,9 +97,80 @@ public:
         mMainControlHeapAddr[3] = pOverruns;
     }
 
+    /**
+     * When enabled, the control process streams the log heaps to
+     * <project>.zlog in the project directory while the loop runs.
+     */
+    inline bool logStreaming(){ return mMainControlHeapAddr[4] != 0; }
+    void setLogStreaming(bool pOn) {
+        mMainControlHeapAddr[4] = pOn ? 1 : 0;
+    }
+
+    /** How far the log streamer is behind the loop, in seconds */
+    inline double logStreamLag(){ return mMainControlHeapAddr[5]; }
+    void setLogStreamLag(double pLag) {
+        mMainControlHeapAddr[5] = pLag;
+    }
+
+    /** Records overwritten in a ring heap before they were streamed */
+    inline double logStreamDropped(){ return mMainControlHeapAddr[6]; }
+    void setLogStreamDropped(double pDropped) {
+        mMainControlHeapAddr[6] = pDropped;
+    }
+
+    /**
+     * When enabled, the log streamer writes the chunks compressed
+     * losslessly with LogCodec.
+     */
+    inline bool logCompression(){ return mMainControlHeapAddr[7] != 0; }
+    void setLogCompression(bool pOn) {
+        mMainControlHeapAddr[7] = pOn ? 1 : 0;
+    }
+
+    /**
+     * Sets ring buffer capacity (in samples) of all log variables.
+     * 0 means linear heaps sized by frequency * duration.
+     */
+    void setLogRingCapacity(unsigned int pCapacity);
+    unsigned int logRingCapacity() { return mLogRingCapacity; }
+
+    /**
+     * Frame logging packs log variables with the same frequency, start
+     * time, duration, ring capacity and trigger into one record per tick
+     * that carries a single time stamp. When disabled, every log variable
+     * is recorded in its own frame.
+     */
+    void setFrameLogging(bool pOn) { mFrameLogging = pOn; }
+    bool frameLogging() { return mFrameLogging; }
+
+    const LogFrameList& logFrames();
+
+    /**
+     * GUI: createLogVariablesHeap() her cagrildiginda artar. Heap'ten
+     * okuyan pencereler yeni bir calismayi sequence numaralarindan degil
+     * bu degerin degismesinden anlar.
+     */
+    uint64_t logHeapGeneration() { return mLogHeapGeneration; }
+
     void createLogVariablesHeap();
+
+    /** Heap'i okuyan export'larin birakmasini bekler, sonra heap'i siler. */
     void deleteLogVariablesHeap();
 
+    /**
+     * GUI: heap'i baska bir thread'de okuyan kod (export) okumadan once
+     * heap'i tutar, bitince birakir. Heap tutuldugu surece silinmez.
+     * @return heap yok ise false, bu durumda birakilmaz
+     */
+    bool acquireLogHeap();
+    void releaseLogHeap();
+
+    /**
+     * deleteLogVariablesHeap() heap'in birakilmasini bekliyor ise true.
+     * Heap'i tutan kod okumayi en kisa surede birakmalidir.
+     */
+    bool isLogHeapReleaseRequested() { return mLogHeapReleaseRequested; }
+
     void bindLogVariablesHeap();
     void unbindLogVariableHeap();
 
@@ -60,9 +181,19 @@ public:
     void unbindMessageQueues();
 
     void sendStateRequest(StateRequest pRequest);
-    ssize_t readState(StateRequest *pState);
 
-    void sampleLogVariable( double pSimTimeInSec );
+    /**
+     * Bir mesaj gelene kadar en fazla pTimeoutMs bekler; mesaj geldigi
+     * anda doner.
+     * @return okunan byte sayisi, zaman asiminda -1
+     */
+    ssize_t readState(StateRequest *pState, int pTimeoutMs = 1000);
+
+    /**
+     * Writes the log frames due at loop tick pTick. The schedule is built
+     * by bindLogVariablesHeap() from the main and log frequencies.
+     */
+    void sampleLogVariable( uint64_t pTick, double pSimTimeInSec );
 
     void insertLogVariable(LogVariable*);
     const LogVariableList& logVariables();
@@ -71,25 +202,105 @@ public:
     void insertControlVariable(ControlVariable*);
     const ControlVariableList& controlVariables();
 
-    void writeVariablesToFile();
-    bool readVariablesFromFile();
+    /**
+     * GUI: ControlVariable::setHeapElement() ile degistirilen tum
+     * degerleri control process'e tek seferde yayinlar. Control process
+     * ya commit'in tamamini ya da hicbirini gorur.
+     * @return control process yazilacak tamponu yerinde okudugu icin
+     * commit ertelendi ise false; degerler sonraki cagriya kadar bekler.
+     */
+    bool commitControlVariables();
+
+    /** GUI: commit edilmemis degerleri atar */
+    void discardControlVariables();
+
+    /**
+     * Control process: son okunan commit'ten sonra bir commit yayinlandi
+     * ise yalnizca degisen degiskenleri kullanici degiskenlerine kopyalar.
+     * Yerinde okunan degiskenler kopyalanmaz, commit'in tamponunu
+     * gosterir ve tampon releaseControlVariables()'a kadar degismez.
+     * @return yeni bir commit okundu ise true
+     */
+    bool updateControlVariables();
+
+    /**
+     * Control process: yerinde okunan degiskenlerin tamponunu GUI'ye
+     * birakir. Dongu durdugunda ve duraklatildiginda cagrilir.
+     */
+    void releaseControlVariables();
+
+    /**
+     * Control process: kayitli degiskenlerin isim, boyut, tip ve
+     * aciklamalarini schema block'a yazar. Block terminate'e kadar durur.
+     */
+    void publishSchema();
+    void deleteSchema();
+
+    /**
+     * GUI: schema block'a baglanir ve degiskenleri olusturur.
+     * @return block yok, surumu farkli ya da bozuk ise false
+     */
+    bool readSchema();
 
     void clear();
 
 private:
     static DataRepository* mInstance;
 
+    /** Number of doubles at the beginning of the main control heap */
+    static const int MAIN_HEAP_GLOBALS = 8;
+
     DataRepository();
 
     void assignHeapAddressToVariables();
 
+    ControlBlockHeader* controlBlockHeader();
+    std::atomic<uint64_t>* controlBlockModified();
+
+    uint64_t* logArenaOffsets();
+
+    static size_t schemaEntrySize(Variable* pVariable);
+    static char* writeSchemaEntry(char* pAddr, Variable* pVariable);
+    static const char* readSchemaEntry(const char* pAddr, const char* pEnd,
+                                       SchemaEntry* pEntry, std::string* pName,
+                                       std::string* pDesc);
+
+    void clearLogFrames();
+
     std::string mProjectName;
     LogVariableList mLogVariables;
+    LogFrameList mLogFrames;
+    LogScheduler mLogScheduler;
+    bool mFrameLogging;
     ControlVariableList mControlVariables;
 
+    /** Control process tarafinda okunan son commit */
+    uint64_t mControlGeneration;
+
+    /** Yerinde okunan control degiskeni varsa true */
+    bool mControlInPlace;
+
+    /** Control process bir tamponu yerinde okuyor ise true */
+    bool mControlHeld;
+
+    unsigned int mLogRingCapacity;
+
+    uint64_t mLogHeapGeneration;
+
     SharedMem* mMainControlHeap;
     double* mMainControlHeapAddr;
 
+    SharedMem* mLogHeap;
+    char* mLogHeapAddr;
+
+    // Heap'i tutan export sayisi
+    std::mutex mLogHeapMutex;
+    std::condition_variable mLogHeapReleased;
+    int mLogHeapUsers;
+    std::atomic<bool> mLogHeapReleaseRequested;
+
+    SharedMem* mSchema;
+
     MsgQueue* mSender;
     MsgQueue* mReceiver;
 };
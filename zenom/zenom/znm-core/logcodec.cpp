@@ -0,0 +1,392 @@
+/*
+ * LogCodec.cpp
+ *
+ *  Lossless compression of log records (Gorilla style).
+ */
+
+#include "logcodec.h"
+#include <cstring>
+
+namespace
+{
+
+uint64_t toBits(double pValue)
+{
+    uint64_t bits;
+    std::memcpy( &bits, &pValue, sizeof(bits) );
+    return bits;
+}
+
+double fromBits(uint64_t pBits)
+{
+    double value;
+    std::memcpy( &value, &pBits, sizeof(value) );
+    return value;
+}
+
+/** Writes bits most significant first. */
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<uint8_t>& pOut)
+        : mOut(pOut), mBuffer(0), mCount(0) {}
+
+    // pBits <= 32
+    void write(uint64_t pValue, unsigned int pBits)
+    {
+        mBuffer = (mBuffer << pBits) | (pValue & ((1ull << pBits) - 1));
+        mCount += pBits;
+        while ( mCount >= 8 )
+        {
+            mCount -= 8;
+            mOut.push_back( (uint8_t)(mBuffer >> mCount) );
+        }
+    }
+
+    // pBits <= 64
+    void writeLong(uint64_t pValue, unsigned int pBits)
+    {
+        if ( pBits > 32 )
+        {
+            write( pValue >> 32, pBits - 32 );
+            write( pValue, 32 );
+        }
+        else
+        {
+            write( pValue, pBits );
+        }
+    }
+
+    void flush()
+    {
+        if ( mCount )
+            mOut.push_back( (uint8_t)(mBuffer << (8 - mCount)) );
+        mCount = 0;
+    }
+
+private:
+    std::vector<uint8_t>& mOut;
+    uint64_t mBuffer;
+    unsigned int mCount;
+};
+
+class BitReader
+{
+public:
+    BitReader(const uint8_t* pBegin, const uint8_t* pEnd)
+        : mData(pBegin), mEnd(pEnd), mBuffer(0), mCount(0), mOverrun(false) {}
+
+    // pBits <= 32
+    uint64_t read(unsigned int pBits)
+    {
+        while ( mCount < pBits )
+        {
+            if ( mData < mEnd )
+                mBuffer = (mBuffer << 8) | *mData++;
+            else
+            {
+                mBuffer <<= 8;
+                mOverrun = true;
+            }
+            mCount += 8;
+        }
+        mCount -= pBits;
+        return (mBuffer >> mCount) & ((1ull << pBits) - 1);
+    }
+
+    // pBits <= 64
+    uint64_t readLong(unsigned int pBits)
+    {
+        if ( pBits > 32 )
+        {
+            uint64_t high = read( pBits - 32 );
+            return (high << 32) | read( 32 );
+        }
+        return read( pBits );
+    }
+
+    bool overrun() { return mOverrun; }
+
+private:
+    const uint8_t* mData;
+    const uint8_t* mEnd;
+    uint64_t mBuffer;
+    unsigned int mCount;
+    bool mOverrun;
+};
+
+// Delta of delta of the bit patterns. For positive doubles in one binade
+// the pattern grows linearly with the value, so regular time stamps give
+// small second differences.
+void encodeDelta(const double* pValues, uint32_t pCount, size_t pStride,
+                 std::vector<uint8_t>& pOut)
+{
+    BitWriter writer( pOut );
+
+    uint64_t previous = toBits( pValues[0] );
+    writer.writeLong( previous, 64 );
+
+    uint64_t previousDelta = 0;
+    for (uint32_t i = 1; i < pCount; ++i)
+    {
+        const uint64_t current = toBits( pValues[i * pStride] );
+        const uint64_t delta = current - previous;
+        const int64_t dod = (int64_t)(delta - previousDelta);
+
+        if ( dod == 0 )
+        {
+            writer.write( 0, 1 );
+        }
+        else if ( -63 <= dod && dod <= 64 )
+        {
+            writer.write( 0x2, 2 );
+            writer.write( dod + 63, 7 );
+        }
+        else if ( -255 <= dod && dod <= 256 )
+        {
+            writer.write( 0x6, 3 );
+            writer.write( dod + 255, 9 );
+        }
+        else if ( -2047 <= dod && dod <= 2048 )
+        {
+            writer.write( 0xe, 4 );
+            writer.write( dod + 2047, 12 );
+        }
+        else if ( INT32_MIN <= dod && dod <= INT32_MAX )
+        {
+            writer.write( 0x1e, 5 );
+            writer.write( (uint32_t)(int32_t)dod, 32 );
+        }
+        else
+        {
+            writer.write( 0x1f, 5 );
+            writer.writeLong( (uint64_t)dod, 64 );
+        }
+
+        previousDelta = delta;
+        previous = current;
+    }
+    writer.flush();
+}
+
+bool decodeDelta(const uint8_t* pBegin, const uint8_t* pEnd, uint32_t pCount,
+                 double* pDest, size_t pStride)
+{
+    BitReader reader( pBegin, pEnd );
+
+    uint64_t previous = reader.readLong( 64 );
+    pDest[0] = fromBits( previous );
+
+    uint64_t previousDelta = 0;
+    for (uint32_t i = 1; i < pCount; ++i)
+    {
+        int64_t dod;
+        if ( reader.read(1) == 0 )
+            dod = 0;
+        else if ( reader.read(1) == 0 )
+            dod = (int64_t)reader.read(7) - 63;
+        else if ( reader.read(1) == 0 )
+            dod = (int64_t)reader.read(9) - 255;
+        else if ( reader.read(1) == 0 )
+            dod = (int64_t)reader.read(12) - 2047;
+        else if ( reader.read(1) == 0 )
+            dod = (int32_t)(uint32_t)reader.read(32);
+        else
+            dod = (int64_t)reader.readLong(64);
+
+        const uint64_t delta = previousDelta + (uint64_t)dod;
+        previous += delta;
+        previousDelta = delta;
+        pDest[i * pStride] = fromBits( previous );
+    }
+
+    return !reader.overrun();
+}
+
+// XOR with the previous value, storing only the bits that changed.
+void encodeXor(const double* pValues, uint32_t pCount, size_t pStride,
+               std::vector<uint8_t>& pOut)
+{
+    BitWriter writer( pOut );
+
+    uint64_t previous = toBits( pValues[0] );
+    writer.writeLong( previous, 64 );
+
+    unsigned int previousLeading = 64;  // no window yet
+    unsigned int previousTrailing = 0;
+    for (uint32_t i = 1; i < pCount; ++i)
+    {
+        const uint64_t current = toBits( pValues[i * pStride] );
+        const uint64_t x = current ^ previous;
+        previous = current;
+
+        if ( x == 0 )
+        {
+            writer.write( 0, 1 );
+            continue;
+        }
+
+        unsigned int leading = __builtin_clzll( x );
+        const unsigned int trailing = __builtin_ctzll( x );
+        if ( leading > 31 )
+            leading = 31;
+
+        if ( previousLeading < 64 && leading >= previousLeading &&
+             trailing >= previousTrailing )
+        {
+            writer.write( 0x2, 2 );
+            writer.writeLong( x >> previousTrailing,
+                              64 - previousLeading - previousTrailing );
+        }
+        else
+        {
+            const unsigned int length = 64 - leading - trailing;
+            writer.write( 0x3, 2 );
+            writer.write( leading, 5 );
+            writer.write( length - 1, 6 );
+            writer.writeLong( x >> trailing, length );
+            previousLeading = leading;
+            previousTrailing = trailing;
+        }
+    }
+    writer.flush();
+}
+
+bool decodeXor(const uint8_t* pBegin, const uint8_t* pEnd, uint32_t pCount,
+               double* pDest, size_t pStride)
+{
+    BitReader reader( pBegin, pEnd );
+
+    uint64_t previous = reader.readLong( 64 );
+    pDest[0] = fromBits( previous );
+
+    unsigned int leading = 64;
+    unsigned int trailing = 0;
+    for (uint32_t i = 1; i < pCount; ++i)
+    {
+        if ( reader.read(1) )
+        {
+            if ( reader.read(1) )
+            {
+                leading = reader.read( 5 );
+                const unsigned int length = reader.read( 6 ) + 1;
+                if ( leading + length > 64 )
+                    return false;
+                trailing = 64 - leading - length;
+            }
+            else if ( leading == 64 )
+            {
+                return false;   // window used before it was set
+            }
+
+            previous ^= reader.readLong( 64 - leading - trailing ) << trailing;
+        }
+        pDest[i * pStride] = fromBits( previous );
+    }
+
+    return !reader.overrun();
+}
+
+}
+
+void LogCodec::encode(const double* pRecords, uint32_t pCount,
+                      uint32_t pRecordSize, std::vector<uint8_t>& pOut)
+{
+    const size_t begin = pOut.size();
+    const size_t tableSize = (pRecordSize + 1) * sizeof(uint32_t);
+    pOut.resize( begin + tableSize );
+
+    std::vector<uint8_t> delta, xored;
+    for (uint32_t column = 0; column < pRecordSize; ++column)
+    {
+        const uint32_t offset = pOut.size() - begin;
+        std::memcpy( &pOut[begin + column * sizeof(uint32_t)], &offset, sizeof(offset) );
+
+        const double* values = pRecords + column;
+        const size_t rawSize = pCount * sizeof(double);
+
+        delta.clear();
+        xored.clear();
+        if ( pCount )
+        {
+            encodeDelta( values, pCount, pRecordSize, delta );
+            encodeXor( values, pCount, pRecordSize, xored );
+        }
+
+        if ( rawSize <= delta.size() && rawSize <= xored.size() )
+        {
+            pOut.push_back( LOG_CODEC_RAW );
+            for (uint32_t i = 0; i < pCount; ++i)
+            {
+                const uint8_t* value = (const uint8_t*)&values[i * pRecordSize];
+                pOut.insert( pOut.end(), value, value + sizeof(double) );
+            }
+        }
+        else if ( delta.size() <= xored.size() )
+        {
+            pOut.push_back( LOG_CODEC_DELTA );
+            pOut.insert( pOut.end(), delta.begin(), delta.end() );
+        }
+        else
+        {
+            pOut.push_back( LOG_CODEC_XOR );
+            pOut.insert( pOut.end(), xored.begin(), xored.end() );
+        }
+    }
+
+    const uint32_t end = pOut.size() - begin;
+    std::memcpy( &pOut[begin + pRecordSize * sizeof(uint32_t)], &end, sizeof(end) );
+}
+
+bool LogCodec::decodeColumn(const uint8_t* pData, size_t pBytes,
+                            uint32_t pCount, uint32_t pRecordSize,
+                            uint32_t pColumn, double* pDest, size_t pStride)
+{
+    const size_t tableSize = (pRecordSize + 1) * sizeof(uint32_t);
+    if ( pColumn >= pRecordSize || pBytes < tableSize )
+        return false;
+
+    uint32_t begin, end;
+    std::memcpy( &begin, pData + pColumn * sizeof(uint32_t), sizeof(begin) );
+    std::memcpy( &end, pData + (pColumn + 1) * sizeof(uint32_t), sizeof(end) );
+    if ( begin < tableSize || end <= begin || end > pBytes )
+        return false;
+
+    if ( pCount == 0 )
+        return true;
+
+    const uint8_t* data = pData + begin + 1;
+    const uint8_t* dataEnd = pData + end;
+    switch ( pData[begin] )
+    {
+    case LOG_CODEC_RAW:
+        if ( (size_t)(dataEnd - data) != pCount * sizeof(double) )
+            return false;
+        for (uint32_t i = 0; i < pCount; ++i)
+        {
+            std::memcpy( &pDest[i * pStride], data + i * sizeof(double), sizeof(double) );
+        }
+        return true;
+
+    case LOG_CODEC_DELTA:
+        return decodeDelta( data, dataEnd, pCount, pDest, pStride );
+
+    case LOG_CODEC_XOR:
+        return decodeXor( data, dataEnd, pCount, pDest, pStride );
+
+    default:
+        return false;
+    }
+}
+
+bool LogCodec::decode(const uint8_t* pData, size_t pBytes,
+                      uint32_t pCount, uint32_t pRecordSize, double* pRecords)
+{
+    for (uint32_t column = 0; column < pRecordSize; ++column)
+    {
+        if ( !decodeColumn(pData, pBytes, pCount, pRecordSize, column,
+                           pRecords + column, pRecordSize) )
+            return false;
+    }
+    return true;
+}
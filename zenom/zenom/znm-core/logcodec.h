@@ -0,0 +1,58 @@
+/*
+ * LogCodec.h
+ *
+ *  Lossless compression of log records (Gorilla style).
+ */
+
+#ifndef LOGCODEC_H_
+#define LOGCODEC_H_
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Kayitlari sutun sutun, kayipsiz olarak sikistirir.
+ *
+ * Sikistirilmis blok recordSize + 1 adet uint32 ile baslar; i. sayi
+ * i. sutunun blok icindeki baslangicidir, sonuncusu blogun uzunlugudur.
+ * Her sutun bir kodlama byte'i ve bit dizisi ile devam eder:
+ *  - LOG_CODEC_RAW: degerler oldugu gibi,
+ *  - LOG_CODEC_DELTA: double'in bitleri tam sayi olarak alinip farkin
+ *    farki kodlanir (duzenli artan zaman etiketleri icin),
+ *  - LOG_CODEC_XOR: her deger bir oncekiyle XOR'lanir ve yalnizca
+ *    degisen bitler yazilir (yavas degisen sinyaller icin).
+ * Her sutun icin en kisa sonucu veren kodlama secilir.
+ */
+class LogCodec
+{
+public:
+    enum Encoding
+    {
+        LOG_CODEC_RAW = 0,
+        LOG_CODEC_DELTA = 1,
+        LOG_CODEC_XOR = 2
+    };
+
+    /**
+     * pCount kaydi (her biri pRecordSize double) sikistirip pOut'un
+     * sonuna ekler.
+     */
+    static void encode(const double* pRecords, uint32_t pCount,
+                       uint32_t pRecordSize, std::vector<uint8_t>& pOut);
+
+    /**
+     * Blogun pColumn sutununu acar. Degerler pDest'e pStride double
+     * aralikla yazilir.
+     * @return blok bozuk ise false
+     */
+    static bool decodeColumn(const uint8_t* pData, size_t pBytes,
+                             uint32_t pCount, uint32_t pRecordSize,
+                             uint32_t pColumn, double* pDest, size_t pStride);
+
+    /** Blogun butun sutunlarini pRecords'a kayit duzeninde acar. */
+    static bool decode(const uint8_t* pData, size_t pBytes,
+                       uint32_t pCount, uint32_t pRecordSize, double* pRecords);
+};
+
+#endif /* LOGCODEC_H_ */
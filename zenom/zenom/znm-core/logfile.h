@@ -0,0 +1,84 @@
+/*
+ * LogFile.h
+ *
+ *  Layout of the log file streamed to disk by the control process.
+ */
+
+#ifndef LOGFILE_H_
+#define LOGFILE_H_
+
+#include <cstdint>
+
+/**
+ * Log dosyasinin yapisi (butun sayilar little endian):
+ *
+ *  LogFileHeader
+ *  Sema: her frame icin bir LogFileFrame ve ardindan frame'in her
+ *        degiskeni icin uint32 isim uzunlugu, isim, uint32 satir,
+ *        uint32 sutun sayisi ve uint32 eleman tipi (VariableType).
+ *  Chunk'lar: LogFileChunk ve ardindan bytes byte veri. Bir kayit
+ *        frame'in recordSize adet 8 byte'lik sutunudur, ilk sutun zaman
+ *        etiketidir. Degiskenler heap'teki gibi kendi tiplerinde
+ *        sikistirilmistir (LogVariable::recordColumns).
+ *        Bir chunk tek bir frame'in ardisik sequence numarali en fazla
+ *        chunkRecords kaydini tutar. encoding LOG_FILE_RAW ise veri
+ *        count adet kayittir, LOG_FILE_COMPRESSED ise kayitlar LogCodec
+ *        ile sikistirilmistir (logcodec.h).
+ *  Indeks: her chunk icin bir LogFileIndexEntry.
+ *  LogFileFooter
+ *
+ * Indeks ve footer dosya kapatilirken yazilir. Bunlar yoksa (program
+ * cokmus ise) okuyucu indeksi chunk basliklarindan cikarir.
+ */
+struct LogFileHeader
+{
+    char magic[4];          // "ZLOG"
+    uint32_t version;
+    uint32_t frameCount;
+    uint32_t reserved;
+};
+
+struct LogFileFrame
+{
+    double frequency;
+    uint32_t recordSize;        // 8 byte'lik sutun cinsinden, zaman etiketi dahil
+    uint32_t variableCount;
+    uint32_t chunkRecords;      // bir chunk'taki en fazla kayit sayisi
+    uint32_t reserved;
+};
+
+struct LogFileChunk
+{
+    uint32_t frame;             // frame indisi
+    uint32_t count;             // chunk'taki kayit sayisi
+    uint64_t firstSequence;     // ilk kaydin sequence numarasi
+    double firstTime;           // ilk kaydin zaman etiketi
+    double lastTime;            // son kaydin zaman etiketi
+    uint32_t encoding;          // LOG_FILE_RAW veya LOG_FILE_COMPRESSED
+    uint32_t bytes;             // basliktan sonraki veri, byte
+};
+
+struct LogFileIndexEntry
+{
+    LogFileChunk chunk;
+    uint64_t offset;            // chunk basliginin dosyadaki yeri
+};
+
+struct LogFileFooter
+{
+    uint64_t indexOffset;       // ilk LogFileIndexEntry'nin dosyadaki yeri
+    uint64_t entryCount;
+    char magic[4];              // "ZIDX"
+    uint32_t reserved;
+};
+
+const uint32_t LOG_FILE_VERSION = 4;
+
+/** Chunk verisinin kodlamasi */
+const uint32_t LOG_FILE_RAW = 0;
+const uint32_t LOG_FILE_COMPRESSED = 1;
+
+/** Bir chunk'in hedef boyutu, byte */
+const uint32_t LOG_FILE_CHUNK_BYTES = 1 << 20;
+
+#endif /* LOGFILE_H_ */
@@ -0,0 +1,372 @@
+/*
+ * LogFileReader.cpp
+ *
+ *  Random access reader for the log files written by LogStreamer.
+ */
+
+#include "logfilereader.h"
+#include "logcodec.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+LogFileReader::LogFileReader()
+{
+
+}
+
+bool LogFileReader::open(const std::string& pFileName)
+{
+    close();
+
+    mFile.open( pFileName.c_str(), std::ios::in | std::ios::binary );
+    if ( !mFile.is_open() )
+        return false;
+
+    mFile.seekg( 0, std::ios::end );
+    const uint64_t fileSize = mFile.tellg();
+    mFile.seekg( 0, std::ios::beg );
+
+    if ( !readSchema() )
+    {
+        std::cerr << pFileName << " is not a log file." << std::endl;
+        close();
+        return false;
+    }
+
+    const uint64_t schemaEnd = mFile.tellg();
+    if ( !readIndex(schemaEnd, fileSize) )
+    {
+        // The writer did not close the file, rebuild the index.
+        for (size_t i = 0; i < mFrames.size(); ++i)
+        {
+            mFrames[i].chunks.clear();
+        }
+        scanChunks( schemaEnd, fileSize );
+    }
+
+    return true;
+}
+
+void LogFileReader::close()
+{
+    if ( mFile.is_open() )
+        mFile.close();
+    mFile.clear();
+    mFrames.clear();
+}
+
+bool LogFileReader::isOpen()
+{
+    return mFile.is_open();
+}
+
+const std::vector<LogFileReader::Frame>& LogFileReader::frames()
+{
+    return mFrames;
+}
+
+bool LogFileReader::readSchema()
+{
+    LogFileHeader header;
+    if ( !mFile.read( (char*)&header, sizeof(header) ) ||
+         std::memcmp( header.magic, "ZLOG", 4 ) != 0 ||
+         header.version != LOG_FILE_VERSION )
+        return false;
+
+    mFrames.resize( header.frameCount );
+    for (uint32_t i = 0; i < header.frameCount; ++i)
+    {
+        LogFileFrame frame;
+        if ( !mFile.read( (char*)&frame, sizeof(frame) ) )
+            return false;
+
+        mFrames[i].frequency = frame.frequency;
+        mFrames[i].recordSize = frame.recordSize;
+        mFrames[i].variables.resize( frame.variableCount );
+
+        unsigned int column = 1;    // time stamp
+        for (uint32_t j = 0; j < frame.variableCount; ++j)
+        {
+            Variable& variable = mFrames[i].variables[j];
+
+            uint32_t values[4];
+            if ( !mFile.read( (char*)values, sizeof(uint32_t) ) )
+                return false;
+            variable.name.resize( values[0] );
+            if ( !mFile.read( &variable.name[0], values[0] ) ||
+                 !mFile.read( (char*)&values[1], 3 * sizeof(uint32_t) ) ||
+                 values[3] > VARIABLE_BOOL )
+                return false;
+
+            variable.row = values[1];
+            variable.col = values[2];
+            variable.type = (VariableType)values[3];
+            variable.column = column;
+            column += ( variable.row * variable.col
+                        * variableTypeSize(variable.type) + 7 ) / 8;
+        }
+
+        if ( column != frame.recordSize )
+            return false;
+    }
+
+    return true;
+}
+
+bool LogFileReader::readIndex(uint64_t pSchemaEnd, uint64_t pFileSize)
+{
+    if ( pFileSize < pSchemaEnd + sizeof(LogFileFooter) )
+        return false;
+
+    LogFileFooter footer;
+    mFile.seekg( pFileSize - sizeof(LogFileFooter) );
+    if ( !mFile.read( (char*)&footer, sizeof(footer) ) ||
+         std::memcmp( footer.magic, "ZIDX", 4 ) != 0 ||
+         footer.indexOffset < pSchemaEnd ||
+         footer.indexOffset + footer.entryCount * sizeof(LogFileIndexEntry)
+            != pFileSize - sizeof(LogFileFooter) )
+    {
+        mFile.clear();
+        return false;
+    }
+
+    std::vector<LogFileIndexEntry> entries( footer.entryCount );
+    mFile.seekg( footer.indexOffset );
+    if ( !mFile.read( (char*)entries.data(),
+                      entries.size() * sizeof(LogFileIndexEntry) ) )
+    {
+        mFile.clear();
+        return false;
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        if ( !addChunk(entries[i]) )
+            return false;
+    }
+
+    return true;
+}
+
+void LogFileReader::scanChunks(uint64_t pSchemaEnd, uint64_t pFileSize)
+{
+    uint64_t offset = pSchemaEnd;
+    LogFileIndexEntry entry;
+    while ( offset + sizeof(LogFileChunk) <= pFileSize )
+    {
+        mFile.seekg( offset );
+        if ( !mFile.read( (char*)&entry.chunk, sizeof(LogFileChunk) ) ||
+             entry.chunk.frame >= mFrames.size() )
+            break;
+
+        const uint64_t end = offset + sizeof(LogFileChunk) + entry.chunk.bytes;
+
+        // The last chunk may be cut short by a crash.
+        if ( end > pFileSize )
+            break;
+
+        entry.offset = offset;
+        if ( !addChunk(entry) )
+            break;
+
+        offset = end;
+    }
+    mFile.clear();
+}
+
+bool LogFileReader::addChunk(const LogFileIndexEntry& pEntry)
+{
+    if ( pEntry.chunk.frame >= mFrames.size() )
+        return false;
+
+    const uint64_t rawBytes = (uint64_t)pEntry.chunk.count
+            * mFrames[pEntry.chunk.frame].recordSize * sizeof(double);
+    if ( pEntry.chunk.encoding == LOG_FILE_RAW ? pEntry.chunk.bytes != rawBytes
+                                               : pEntry.chunk.encoding != LOG_FILE_COMPRESSED )
+        return false;
+
+    mFrames[pEntry.chunk.frame].chunks.push_back( pEntry );
+    return true;
+}
+
+bool LogFileReader::findVariable(const std::string& pName,
+                                 unsigned int* pFrame, unsigned int* pColumn)
+{
+    for (unsigned int i = 0; i < mFrames.size(); ++i)
+    {
+        for (unsigned int j = 0; j < mFrames[i].variables.size(); ++j)
+        {
+            if ( mFrames[i].variables[j].name == pName )
+            {
+                *pFrame = i;
+                *pColumn = mFrames[i].variables[j].column;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint64_t LogFileReader::recordCount(unsigned int pFrame)
+{
+    uint64_t count = 0;
+    const std::vector<LogFileIndexEntry>& chunks = mFrames[pFrame].chunks;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        count += chunks[i].chunk.count;
+    }
+    return count;
+}
+
+bool LogFileReader::timeRange(unsigned int pFrame, double* pBegin, double* pEnd)
+{
+    const std::vector<LogFileIndexEntry>& chunks = mFrames[pFrame].chunks;
+    if ( chunks.empty() )
+        return false;
+
+    *pBegin = chunks.front().chunk.firstTime;
+    *pEnd = chunks.back().chunk.lastTime;
+    return true;
+}
+
+size_t LogFileReader::readRecords(unsigned int pFrame, double pBegin, double pEnd,
+                                  std::vector<double>& pRecords)
+{
+    const Frame& frame = mFrames[pFrame];
+    const unsigned int recordSize = frame.recordSize;
+
+    size_t count = 0;
+    for (ChunkIterator it = findChunk(frame, pBegin);
+         it != frame.chunks.end() && it->chunk.firstTime <= pEnd; ++it)
+    {
+        mChunkBuffer.resize( it->chunk.count * recordSize );
+        if ( !readChunk(*it) ||
+             !decodeColumns(*it, recordSize, 0, recordSize, mChunkBuffer.data()) )
+            break;
+
+        for (uint32_t i = 0; i < it->chunk.count; ++i)
+        {
+            const double* record = &mChunkBuffer[i * recordSize];
+            if ( pBegin <= record[0] && record[0] <= pEnd )
+            {
+                pRecords.insert( pRecords.end(), record, record + recordSize );
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+size_t LogFileReader::readVariable(const std::string& pName,
+                                   double pBegin, double pEnd,
+                                   std::vector<double>& pTimes,
+                                   std::vector<double>& pValues)
+{
+    unsigned int frameIndex, column;
+    if ( !findVariable(pName, &frameIndex, &column) )
+        return 0;
+
+    const Frame& frame = mFrames[frameIndex];
+    unsigned int size = 0;
+    VariableType type = VARIABLE_DOUBLE;
+    for (size_t i = 0; i < frame.variables.size(); ++i)
+    {
+        const Variable& variable = frame.variables[i];
+        if ( variable.column == column )
+        {
+            size = variable.row * variable.col;
+            type = variable.type;
+        }
+    }
+    const unsigned int columns = ( size * variableTypeSize(type) + 7 ) / 8;
+
+    // Only the time stamps and the columns of the variable are decoded.
+    size_t count = 0;
+    for (ChunkIterator it = findChunk(frame, pBegin);
+         it != frame.chunks.end() && it->chunk.firstTime <= pEnd; ++it)
+    {
+        mTimeBuffer.resize( it->chunk.count );
+        mChunkBuffer.resize( it->chunk.count * columns );
+        if ( !readChunk(*it) ||
+             !decodeColumns(*it, frame.recordSize, 0, 1, mTimeBuffer.data()) ||
+             !decodeColumns(*it, frame.recordSize, column, columns, mChunkBuffer.data()) )
+            break;
+
+        for (uint32_t i = 0; i < it->chunk.count; ++i)
+        {
+            if ( pBegin <= mTimeBuffer[i] && mTimeBuffer[i] <= pEnd )
+            {
+                const double* values = &mChunkBuffer[i * columns];
+                pTimes.push_back( mTimeBuffer[i] );
+                if ( type == VARIABLE_DOUBLE )
+                {
+                    pValues.insert( pValues.end(), values, values + size );
+                }
+                else
+                {
+                    const char* element = (const char*)values;
+                    for (unsigned int j = 0; j < size; ++j)
+                    {
+                        pValues.push_back( variableElementToDouble(element, type) );
+                        element += variableTypeSize(type);
+                    }
+                }
+                ++count;
+            }
+        }
+    }
+
+    return count;
+}
+
+LogFileReader::ChunkIterator LogFileReader::findChunk(const Frame& pFrame, double pTime)
+{
+    // First chunk that ends at or after pTime.
+    return std::lower_bound( pFrame.chunks.begin(), pFrame.chunks.end(), pTime,
+                             [](const LogFileIndexEntry& pEntry, double pValue)
+                             { return pEntry.chunk.lastTime < pValue; } );
+}
+
+bool LogFileReader::readChunk(const LogFileIndexEntry& pEntry)
+{
+    mChunkData.resize( pEntry.chunk.bytes );
+    mFile.seekg( pEntry.offset + sizeof(LogFileChunk) );
+    if ( !mFile.read( (char*)mChunkData.data(), mChunkData.size() ) )
+    {
+        mFile.clear();
+        return false;
+    }
+    return true;
+}
+
+bool LogFileReader::decodeColumns(const LogFileIndexEntry& pEntry,
+                                  unsigned int pRecordSize,
+                                  unsigned int pFirst, unsigned int pCount,
+                                  double* pDest)
+{
+    const uint32_t records = pEntry.chunk.count;
+    if ( pEntry.chunk.encoding == LOG_FILE_RAW )
+    {
+        const double* data = (const double*)mChunkData.data();
+        for (uint32_t i = 0; i < records; ++i)
+        {
+            std::memcpy( pDest + i * pCount, data + i * pRecordSize + pFirst,
+                         pCount * sizeof(double) );
+        }
+        return true;
+    }
+
+    for (unsigned int j = 0; j < pCount; ++j)
+    {
+        if ( !LogCodec::decodeColumn(mChunkData.data(), mChunkData.size(),
+                                     records, pRecordSize, pFirst + j,
+                                     pDest + j, pCount) )
+        {
+            std::cerr << "Corrupt log chunk at " << pEntry.offset << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
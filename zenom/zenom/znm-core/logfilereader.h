@@ -0,0 +1,122 @@
+/*
+ * LogFileReader.h
+ *
+ *  Random access reader for the log files written by LogStreamer.
+ */
+
+#ifndef LOGFILEREADER_H_
+#define LOGFILEREADER_H_
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "logfile.h"
+#include "variable.h"
+
+/**
+ * Log dosyasini acar ve zaman araligi verilen kayitlari okur. Acilista
+ * yalnizca sema ve zaman indeksi okunur; bir aralik okunurken indekste
+ * ikili arama ile araligi kesen chunk'lar bulunur ve sadece onlar okunur.
+ */
+class LogFileReader
+{
+public:
+    struct Variable
+    {
+        std::string name;
+        unsigned int row;
+        unsigned int col;
+        VariableType type;
+        unsigned int column;    // kayit icindeki ilk sutun
+    };
+
+    struct Frame
+    {
+        double frequency;
+        unsigned int recordSize;
+        std::vector<Variable> variables;
+
+        /** Frame'in chunk'lari, zamana gore sirali */
+        std::vector<LogFileIndexEntry> chunks;
+    };
+
+    LogFileReader();
+
+    /**
+     * Dosyayi acar, semayi ve zaman indeksini okur.
+     * @return dosya log dosyasi degil ise false
+     */
+    bool open(const std::string& pFileName);
+
+    void close();
+
+    bool isOpen();
+
+    const std::vector<Frame>& frames();
+
+    /**
+     * Degiskenin frame'ini ve kayit icindeki sutununu bulur.
+     * @return degisken yok ise false
+     */
+    bool findVariable(const std::string& pName,
+                      unsigned int* pFrame, unsigned int* pColumn);
+
+    /** Frame'in dosyadaki kayit sayisi */
+    uint64_t recordCount(unsigned int pFrame);
+
+    /** Frame'in ilk ve son kaydinin zamani. Frame bos ise false */
+    bool timeRange(unsigned int pFrame, double* pBegin, double* pEnd);
+
+    /**
+     * Frame'in zaman etiketi [pBegin, pEnd] araliginda olan kayitlarini
+     * pRecords'a ekler (kayit basina recordSize sutun). double olmayan
+     * degiskenlerin sutunlari ham olarak kopyalanir.
+     * @return okunan kayit sayisi
+     */
+    size_t readRecords(unsigned int pFrame, double pBegin, double pEnd,
+                       std::vector<double>& pRecords);
+
+    /**
+     * Degiskenin [pBegin, pEnd] araligindaki orneklerini okur. pValues'a
+     * ornek basina degiskenin size() degeri double olarak eklenir.
+     * @return okunan ornek sayisi, degisken yok ise 0
+     */
+    size_t readVariable(const std::string& pName, double pBegin, double pEnd,
+                        std::vector<double>& pTimes,
+                        std::vector<double>& pValues);
+
+private:
+    bool readSchema();
+
+    bool readIndex(uint64_t pSchemaEnd, uint64_t pFileSize);
+
+    /** Indeks yazilmamis dosyalarda indeksi chunk basliklarindan kurar. */
+    void scanChunks(uint64_t pSchemaEnd, uint64_t pFileSize);
+
+    bool addChunk(const LogFileIndexEntry& pEntry);
+
+    typedef std::vector<LogFileIndexEntry>::const_iterator ChunkIterator;
+
+    /** Frame'in pTime'da veya sonrasinda biten ilk chunk'i */
+    ChunkIterator findChunk(const Frame& pFrame, double pTime);
+
+    /** Chunk'in verisini mChunkData'ya okur. */
+    bool readChunk(const LogFileIndexEntry& pEntry);
+
+    /**
+     * Okunmus chunk'in pFirst'ten baslayan pCount sutununu pDest'e kayit
+     * basina pCount double olarak acar. Sikistirilmis chunk'larda diger
+     * sutunlar acilmaz.
+     */
+    bool decodeColumns(const LogFileIndexEntry& pEntry, unsigned int pRecordSize,
+                       unsigned int pFirst, unsigned int pCount, double* pDest);
+
+    std::ifstream mFile;
+    std::vector<Frame> mFrames;
+    std::vector<uint8_t> mChunkData;
+    std::vector<double> mChunkBuffer;
+    std::vector<double> mTimeBuffer;
+};
+
+#endif /* LOGFILEREADER_H_ */
@@ -0,0 +1,446 @@
+/*
+ * LogFrame.cpp
+ *
+ *  A group of log variables logged into one shared record heap.
+ */
+
+#include "logframe.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+template <typename T>
+double elementAt(const char* pElement)
+{
+    T value;
+    std::memcpy( &value, pElement, sizeof(T) );
+    return static_cast<double>( value );
+}
+
+template <typename T>
+void copyElements(const char* pElement, size_t pRecordBytes, uint64_t pCount,
+                  double* pDest, size_t pStride)
+{
+    for (uint64_t i = 0; i < pCount; ++i)
+    {
+        *pDest = elementAt<T>( pElement );
+        pDest += pStride;
+        pElement += pRecordBytes;
+    }
+}
+
+template <typename T>
+void copySamples(const double* pRecord, unsigned int pRecordSize, uint64_t pCount,
+                 size_t pOffset, double* pDest)
+{
+    for (uint64_t i = 0; i < pCount; ++i)
+    {
+        pDest[0] = pRecord[0];
+        pDest[1] = elementAt<T>( (const char*)pRecord + pOffset );
+        pDest += 2;
+        pRecord += pRecordSize;
+    }
+}
+
+// The type is resolved once per block, not per element.
+void copyElements(const char* pElement, size_t pRecordBytes, uint64_t pCount,
+                  VariableType pType, double* pDest, size_t pStride)
+{
+    switch ( pType )
+    {
+    case VARIABLE_FLOAT:
+        copyElements<float>( pElement, pRecordBytes, pCount, pDest, pStride );
+        break;
+    case VARIABLE_INT32:
+        copyElements<int32_t>( pElement, pRecordBytes, pCount, pDest, pStride );
+        break;
+    case VARIABLE_INT64:
+        copyElements<int64_t>( pElement, pRecordBytes, pCount, pDest, pStride );
+        break;
+    case VARIABLE_BOOL:
+        copyElements<bool>( pElement, pRecordBytes, pCount, pDest, pStride );
+        break;
+    default:
+        copyElements<double>( pElement, pRecordBytes, pCount, pDest, pStride );
+        break;
+    }
+}
+
+void copySamples(const double* pRecord, unsigned int pRecordSize, uint64_t pCount,
+                 size_t pOffset, VariableType pType, double* pDest)
+{
+    switch ( pType )
+    {
+    case VARIABLE_FLOAT:
+        copySamples<float>( pRecord, pRecordSize, pCount, pOffset, pDest );
+        break;
+    case VARIABLE_INT32:
+        copySamples<int32_t>( pRecord, pRecordSize, pCount, pOffset, pDest );
+        break;
+    case VARIABLE_INT64:
+        copySamples<int64_t>( pRecord, pRecordSize, pCount, pOffset, pDest );
+        break;
+    case VARIABLE_BOOL:
+        copySamples<bool>( pRecord, pRecordSize, pCount, pOffset, pDest );
+        break;
+    default:
+        copySamples<double>( pRecord, pRecordSize, pCount, pOffset, pDest );
+        break;
+    }
+}
+
+}
+
+LogFrame::LogFrame()
+    : mRecordSize(1)    // time stamp
+    , mHeapHeader(nullptr)
+    , mHeapBeginAddr(nullptr)
+    , mHeapEndAddr(nullptr)
+    , mHeapAddr(nullptr)
+    , mTriggerAddr(nullptr)
+    , mTriggerType(VARIABLE_DOUBLE)
+    , mTriggerPrevious(0)
+    , mTriggerHasPrevious(false)
+{
+
+}
+
+void LogFrame::addLogVariable(LogVariable* pLogVariable)
+{
+    pLogVariable->setFrame( this, mRecordSize );
+    mRecordSize += pLogVariable->recordColumns();
+    mLogVariables.push_back( pLogVariable );
+}
+
+const std::vector<LogVariable*>& LogFrame::logVariables()
+{
+    return mLogVariables;
+}
+
+double LogFrame::frequency()
+{
+    return mLogVariables.front()->frequency();
+}
+
+double LogFrame::startTime()
+{
+    return mLogVariables.front()->startTime();
+}
+
+double LogFrame::duration()
+{
+    return mLogVariables.front()->duration();
+}
+
+unsigned int LogFrame::ringCapacity()
+{
+    return mLogVariables.front()->ringCapacity();
+}
+
+const LogTrigger& LogFrame::trigger()
+{
+    return mLogVariables.front()->trigger();
+}
+
+unsigned int LogFrame::recordSize()
+{
+    return mRecordSize;
+}
+
+uint64_t LogFrame::requiredCapacity()
+{
+    // A triggered frame keeps the pre-trigger records and the
+    // post-trigger window only.
+    if ( trigger().isEnabled() )
+        return std::max(trigger().preTrigger + trigger().postTrigger, 2u);
+
+    // A ring needs at least two slots so the latest record is never the
+    // one being written.
+    if ( ringCapacity() )
+        return std::max(ringCapacity(), 2u);
+
+    // frequency * duration record, +1 since the tick window is rounded up.
+    return static_cast<uint64_t>( std::ceil(frequency() * duration()) ) + 1;
+}
+
+size_t LogFrame::heapByteSize()
+{
+    return sizeof(LogHeapHeader)
+            + mRecordSize * requiredCapacity() * sizeof(double);
+}
+
+void LogFrame::createHeap(void* pHeapAddr)
+{
+    mHeapHeader = (LogHeapHeader*)pHeapAddr;
+
+    mHeapHeader->writeSequence = 0;
+    mHeapHeader->readSequence = 0;
+    mHeapHeader->capacity = requiredCapacity();
+    mHeapHeader->ringBuffer = ringCapacity() || trigger().isEnabled() ? 1 : 0;
+    mHeapHeader->recordSize = mRecordSize;
+    mHeapHeader->trigger = trigger();
+    mHeapHeader->triggerState = LogTrigger::TRIGGER_ARMED;
+    mHeapHeader->triggerSequence = 0;
+
+    mHeapBeginAddr = (double*)(mHeapHeader + 1);
+    mHeapEndAddr = mHeapBeginAddr + mRecordSize * mHeapHeader->capacity;
+    mHeapAddr = mHeapBeginAddr;
+}
+
+void LogFrame::bindHeap(void* pHeapAddr)
+{
+    mHeapHeader = (LogHeapHeader*)pHeapAddr;
+    mHeapBeginAddr = (double*)(mHeapHeader + 1);
+    mHeapEndAddr = mHeapBeginAddr + mRecordSize * mHeapHeader->capacity;
+    mHeapAddr = mHeapBeginAddr;
+}
+
+bool LogFrame::bindTriggerSource(const std::vector<LogVariable*>& pLogVariables)
+{
+    mTriggerAddr = nullptr;
+    mTriggerHasPrevious = false;
+
+    LogTrigger& trigger = mHeapHeader->trigger;
+    if ( !trigger.isEnabled() )
+        return true;
+
+    // The heap then keeps running as a plain ring buffer.
+    if ( trigger.source >= pLogVariables.size() ||
+         trigger.element >= pLogVariables[trigger.source]->size() )
+    {
+        trigger.mode = LogTrigger::TRIGGER_OFF;
+        return false;
+    }
+
+    LogVariable* source = pLogVariables[trigger.source];
+    mTriggerType = source->type();
+    mTriggerAddr = (const char*)source->mVariableAddr
+            + trigger.element * variableTypeSize(mTriggerType);
+    return true;
+}
+
+void LogFrame::deleteHeap()
+{
+    // The arena owns the memory, the frame only drops its view.
+    mHeapHeader = nullptr;
+    mHeapBeginAddr = nullptr;
+    mHeapEndAddr = nullptr;
+    mHeapAddr = nullptr;
+    mTriggerAddr = nullptr;
+}
+
+void LogFrame::insertToHeap(double pTimeInSec)
+{
+    uint64_t sequence =
+            mHeapHeader->writeSequence.load(std::memory_order_relaxed);
+
+    // Linear heap is full, stop logging.
+    if ( !mHeapHeader->ringBuffer && sequence >= mHeapHeader->capacity )
+        return;
+
+    // Only the loop task changes the trigger state.
+    uint64_t triggerState = LogTrigger::TRIGGER_ARMED;
+    if ( mTriggerAddr )
+    {
+        triggerState = mHeapHeader->triggerState.load(std::memory_order_relaxed);
+        if ( triggerState == LogTrigger::TRIGGER_CAPTURED )
+            return;
+
+        if ( triggerState == LogTrigger::TRIGGER_ARMED )
+        {
+            const double value = variableElementToDouble(mTriggerAddr, mTriggerType);
+            if ( mHeapHeader->trigger.fires(value, mTriggerPrevious, mTriggerHasPrevious) )
+            {
+                triggerState = LogTrigger::TRIGGER_FIRED;
+                mHeapHeader->triggerSequence = sequence;
+                mHeapHeader->triggerState.store(triggerState,
+                                                std::memory_order_release);
+            }
+            mTriggerPrevious = value;
+            mTriggerHasPrevious = true;
+        }
+    }
+
+    // Readers validate their copy against writeSequence, so the
+    // publication of the previous record must be ordered before
+    // the slot is written again.
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // One record: time stamp followed by every variable. Padding at the
+    // end of a column is never written and keeps the zero of the arena.
+    double* record = mHeapAddr;
+    *record++ = pTimeInSec;
+    for (size_t i = 0; i < mLogVariables.size(); ++i)
+    {
+        LogVariable* logVariable = mLogVariables[i];
+        std::memcpy( record, logVariable->mVariableAddr,
+                     logVariable->byteSize() );
+        record += logVariable->recordColumns();
+    }
+
+    mHeapAddr = record;     // set next address
+    if ( mHeapAddr == mHeapEndAddr )
+        mHeapAddr = mHeapBeginAddr;   // wrap around
+
+    // Publish the record after it has been written.
+    mHeapHeader->writeSequence.store(sequence + 1,
+                                     std::memory_order_release);
+
+    // Freeze the heap once the post-trigger window is written.
+    if ( triggerState == LogTrigger::TRIGGER_FIRED &&
+         sequence + 1 >= mHeapHeader->triggerSequence + mHeapHeader->trigger.postTrigger )
+        mHeapHeader->triggerState.store(LogTrigger::TRIGGER_CAPTURED,
+                                        std::memory_order_release);
+}
+
+bool LogFrame::isHeapValid()
+{
+    return (mHeapHeader != nullptr) && heapSize();
+}
+
+int LogFrame::heapSize()
+{
+    uint64_t sequence =
+            mHeapHeader->writeSequence.load(std::memory_order_acquire);
+    return static_cast<int>( std::min(sequence, mHeapHeader->capacity) );
+}
+
+uint64_t LogFrame::heapCapacity()
+{
+    return mHeapHeader->capacity;
+}
+
+bool LogFrame::isRingBuffer()
+{
+    return mHeapHeader->ringBuffer != 0;
+}
+
+uint64_t LogFrame::writeSequence()
+{
+    return mHeapHeader->writeSequence.load(std::memory_order_acquire);
+}
+
+uint64_t LogFrame::firstSequence()
+{
+    uint64_t sequence = writeSequence();
+    return sequence - std::min(sequence, mHeapHeader->capacity);
+}
+
+uint64_t LogFrame::readSequence()
+{
+    return mHeapHeader->readSequence.load(std::memory_order_acquire);
+}
+
+void LogFrame::setReadSequence(uint64_t pSequence)
+{
+    mHeapHeader->readSequence.store(pSequence, std::memory_order_release);
+}
+
+bool LogFrame::isTriggered()
+{
+    return mHeapHeader->trigger.isEnabled();
+}
+
+int LogFrame::triggerState()
+{
+    return static_cast<int>(
+            mHeapHeader->triggerState.load(std::memory_order_acquire) );
+}
+
+uint64_t LogFrame::triggerSequence()
+{
+    return mHeapHeader->triggerSequence;
+}
+
+double* LogFrame::recordBySequence(uint64_t pSequence)
+{
+    return &(mHeapBeginAddr[ (pSequence % mHeapHeader->capacity) * mRecordSize ]);
+}
+
+void LogFrame::copyColumn(uint64_t pFirst, uint64_t pCount,
+                          size_t pOffset, VariableType pType,
+                          double* pDest, size_t pStride)
+{
+    const uint64_t capacity = mHeapHeader->capacity;
+    const size_t recordBytes = mRecordSize * sizeof(double);
+    while ( pCount > 0 )
+    {
+        // Records up to the end of the ring are contiguous.
+        const uint64_t slot = pFirst % capacity;
+        const uint64_t count = std::min( pCount, capacity - slot );
+        const char* value = (const char*)(mHeapBeginAddr + slot * mRecordSize) + pOffset;
+        copyElements( value, recordBytes, count, pType, pDest, pStride );
+        pDest += count * pStride;
+        pFirst += count;
+        pCount -= count;
+    }
+}
+
+void LogFrame::copySamples(uint64_t pFirst, uint64_t pCount,
+                           size_t pOffset, VariableType pType, double* pDest)
+{
+    const uint64_t capacity = mHeapHeader->capacity;
+    while ( pCount > 0 )
+    {
+        const uint64_t slot = pFirst % capacity;
+        const uint64_t count = std::min( pCount, capacity - slot );
+        ::copySamples( mHeapBeginAddr + slot * mRecordSize, mRecordSize,
+                       count, pOffset, pType, pDest );
+        pDest += 2 * count;
+        pFirst += count;
+        pCount -= count;
+    }
+}
+
+uint64_t LogFrame::firstIntactSequence(uint64_t pSequence)
+{
+    if ( !mHeapHeader->ringBuffer )
+        return pSequence;
+
+    // The slot of s is written again for (s + capacity); while that
+    // sequence is being written writeSequence equals it.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t current =
+            mHeapHeader->writeSequence.load(std::memory_order_relaxed);
+    if ( current < mHeapHeader->capacity )
+        return pSequence;
+
+    return std::max(pSequence, current - mHeapHeader->capacity + 1);
+}
+
+bool LogFrame::copyLastRecord(double* pDest, size_t pOffset, VariableType pType,
+                              unsigned int pCount, double* pTime)
+{
+    uint64_t sequence =
+            mHeapHeader->writeSequence.load(std::memory_order_acquire);
+    if ( sequence == 0 )
+        return false;
+
+    for (;;)
+    {
+        const double* record = recordBySequence(sequence - 1);
+        const char* element = (const char*)record + pOffset;
+        for (unsigned int i = 0; i < pCount; ++i)
+        {
+            pDest[i] = variableElementToDouble( element, pType );
+            element += variableTypeSize(pType);
+        }
+        if ( pTime )
+            *pTime = record[0];
+
+        // The slot of (sequence - 1) is written again only for
+        // (sequence - 1 + capacity), which the writer starts after
+        // publishing that sequence. Linear heaps are never overwritten.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t current =
+                mHeapHeader->writeSequence.load(std::memory_order_relaxed);
+        if ( !mHeapHeader->ringBuffer ||
+             current < sequence - 1 + mHeapHeader->capacity )
+            return true;
+
+        sequence = current;
+    }
+}
@@ -0,0 +1,203 @@
+/*
+ * LogFrame.h
+ *
+ *  A group of log variables logged into one shared record heap.
+ */
+
+#ifndef LOGFRAME_H_
+#define LOGFRAME_H_
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "logvariable.h"
+#include "logtrigger.h"
+
+/**
+ * Log heap basliginda yer alan bilgiler. Heap GUI tarafindan olusturulur,
+ * control process tarafindan doldurulur.
+ * Sequence numaralari monoton artar, heap dolup basa sarsa bile sifirlanmaz.
+ */
+struct LogHeapHeader
+{
+    /** Heap'e simdiye kadar yazilan kayit sayisi */
+    std::atomic<uint64_t> writeSequence;
+
+    /** Heap'i bosaltan okuyucunun (export, disk) kaldigi kayit */
+    std::atomic<uint64_t> readSequence;
+
+    /** Heap'in kayit cinsinden kapasitesi */
+    uint64_t capacity;
+
+    /** 1 ise heap dolunca basa sarar (ring buffer), 0 ise yazma durur */
+    uint64_t ringBuffer;
+
+    /** Bir kaydin double cinsinden uzunlugu */
+    uint64_t recordSize;
+
+    /** Tetikleme ayarlari, GUI tarafindan yazilir */
+    LogTrigger trigger;
+
+    /** LogTrigger::State */
+    std::atomic<uint64_t> triggerState;
+
+    /** Tetik kaydinin sequence numarasi */
+    uint64_t triggerSequence;
+};
+
+/**
+ * Ayni frekans, baslangic zamani, sure, kapasite ve tetikleme ile kayit
+ * edilen log degiskenleri grubu. Her kayit aninda grubun tek bir kaydi yazilir:
+ * [zaman etiketi, 1. degiskenin degerleri, 2. degiskenin degerleri, ...]
+ * Zaman etiketi her degisken icin ayri ayri tutulmaz.
+ */
+class LogFrame
+{
+public:
+    LogFrame();
+
+    /**
+     * Degiskeni gruba ekler ve kayit icindeki sutununu belirler.
+     * Heap olusturulmadan once cagrilmalidir.
+     */
+    void addLogVariable(LogVariable* pLogVariable);
+
+    const std::vector<LogVariable*>& logVariables();
+
+    /** Grubun ayarlari ilk degiskenden okunur. */
+    double frequency();
+    double startTime();
+    double duration();
+    unsigned int ringCapacity();
+    const LogTrigger& trigger();
+
+    /**
+     * Bir kaydin 8 byte'lik sutun cinsinden uzunlugu (zaman etiketi
+     * dahil). Degiskenler kendi tiplerinde, sutunlara sikistirilarak
+     * yazilir; her degisken yeni bir sutunda baslar.
+     */
+    unsigned int recordSize();
+
+    /** Heap icin gereken byte sayisi (baslik + kapasite kadar kayit) */
+    size_t heapByteSize();
+
+    // Write Data
+    /**
+     * Log arena icinde pHeapAddr adresindeki alani grubun heap'i olarak
+     * baslatir. Alan en az heapByteSize() byte olmalidir.
+     */
+    void createHeap(void* pHeapAddr);
+
+    void deleteHeap();
+
+    /**
+     * Gruptaki butun degiskenleri tek kayit olarak heap'e yazar. Kaydin
+     * zamaninin gelip gelmedigine LogScheduler karar verir. Tetikleme
+     * acik ise kosul burada degerlendirilir, heap dondurulduktan sonra
+     * kayit yazilmaz.
+     */
+    void insertToHeap(double pTimeInSec);
+
+    // Read Data
+    /**
+     * Log arena icinde pHeapAddr adresinde daha once olusturulmus
+     * heap'e baglanir.
+     */
+    void bindHeap(void* pHeapAddr);
+
+    /**
+     * Heap basligindaki tetikleme kosulunun kaynak degiskenini baglar.
+     * Control process'te bindHeap'ten sonra cagrilir.
+     * @param pLogVariables butun log degiskenleri (DataRepository sirasi)
+     * @return kaynak degisken veya elemani yok ise false, bu durumda
+     *         tetikleme kapatilir
+     */
+    bool bindTriggerSource(const std::vector<LogVariable*>& pLogVariables);
+
+    bool isHeapValid();
+
+    int heapSize();
+
+    uint64_t heapCapacity();
+
+    bool isRingBuffer();
+
+    uint64_t writeSequence();
+
+    uint64_t firstSequence();
+
+    uint64_t readSequence();
+
+    void setReadSequence(uint64_t pSequence);
+
+    /** Heap tetikleme ile kayit ediliyorsa true */
+    bool isTriggered();
+
+    /** LogTrigger::State */
+    int triggerState();
+
+    /** Tetik kaydinin sequence numarasi, TRIGGER_ARMED durumunda anlamsizdir */
+    uint64_t triggerSequence();
+
+    /**
+     * Sequence numarasi verilen kaydi getirir. Kaydin ilk elemani zaman
+     * etiketidir.
+     */
+    double* recordBySequence(uint64_t pSequence);
+
+    /**
+     * [pFirst, pFirst + pCount) sequence araligindaki kayitlarin, kayit
+     * basindan pOffset byte otedeki pType tipindeki elemanini double'a
+     * cevirip pDest'e pStride double aralikla kopyalar. Ring buffer'in
+     * sonuna kadar olan kayitlar ardisik oldugu icin en fazla iki parcada,
+     * tek gecisle kopyalanir.
+     */
+    void copyColumn(uint64_t pFirst, uint64_t pCount,
+                    size_t pOffset, VariableType pType,
+                    double* pDest, size_t pStride = 1);
+
+    /**
+     * copyColumn gibi, fakat pDest'e (zaman etiketi, eleman) ciftleri
+     * yazar.
+     */
+    void copySamples(uint64_t pFirst, uint64_t pCount,
+                     size_t pOffset, VariableType pType, double* pDest);
+
+    /**
+     * pSequence'tan itibaren kopyalanan kayitlardan, kopyalama bittikten
+     * sonra hala ezilmemis olan ilkinin sequence numarasi. Ring buffer'da
+     * yazici kopyalama sirasinda basa sarmis olabilir; copyLastRecord ile
+     * ayni kosul kullanilir. Lineer heap'te pSequence doner.
+     */
+    uint64_t firstIntactSequence(uint64_t pSequence);
+
+    /**
+     * En son kaydin pOffset byte'inda baslayan pCount adet pType tipindeki
+     * elemanini double olarak ve zaman etiketini tutarli olarak kopyalar.
+     * RT yazici hicbir zaman beklemez; okuyucu kopyaladigi slotun
+     * ezilmedigini writeSequence ile dogrular.
+     * @param pTime nullptr degil ise zaman etiketi buraya yazilir
+     * @return heap bos ise false
+     */
+    bool copyLastRecord(double* pDest, size_t pOffset, VariableType pType,
+                        unsigned int pCount, double* pTime = nullptr);
+
+private:
+    uint64_t requiredCapacity();
+
+    std::vector<LogVariable*> mLogVariables;
+    unsigned int mRecordSize;
+
+    LogHeapHeader* mHeapHeader;
+    double* mHeapBeginAddr;
+    double* mHeapEndAddr;
+    double* mHeapAddr;
+
+    // Tetikleme kosulunun degeri, yalnizca control process'te
+    const void* mTriggerAddr;
+    VariableType mTriggerType;
+    double mTriggerPrevious;
+    bool mTriggerHasPrevious;
+};
+
+#endif /* LOGFRAME_H_ */
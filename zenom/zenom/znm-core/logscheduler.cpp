@@ -0,0 +1,129 @@
+/*
+ * LogScheduler.cpp
+ *
+ *  Decides which log frames are written on a loop tick.
+ */
+
+#include "logscheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+// Rounds up, but treats values within floating point noise of an integer
+// (0.1 * 1000 = 100.00000000000001) as that integer.
+uint64_t ceilToInteger(double pValue)
+{
+    if ( !(pValue > 0) )
+        return 0;
+
+    double rounded = std::round(pValue);
+    if ( std::fabs(pValue - rounded) < 1e-6 * std::max(1.0, rounded) )
+        return static_cast<uint64_t>( rounded );
+
+    return static_cast<uint64_t>( std::ceil(pValue) );
+}
+}
+
+LogScheduler::LogScheduler()
+    : mNextTick(NEVER)
+{
+
+}
+
+uint64_t LogScheduler::toTick(double pTimeInSec, double pMainFreq)
+{
+    return ceilToInteger( pTimeInSec * pMainFreq );
+}
+
+void LogScheduler::build(const std::vector<LogFrame*>& pFrames, double pMainFreq)
+{
+    clear();
+
+    for (size_t i = 0; i < pFrames.size(); ++i)
+    {
+        LogFrame* frame = pFrames[i];
+        if ( !(frame->frequency() > 0) || !(frame->duration() > 0) )
+            continue;
+
+        Bucket bucket;
+        bucket.divisor = std::max<uint64_t>( 1, ceilToInteger(pMainFreq / frame->frequency()) );
+        bucket.beginTick = toTick( frame->startTime(), pMainFreq );
+        bucket.endTick = toTick( frame->startTime() + frame->duration(), pMainFreq );
+        bucket.nextTick = bucket.beginTick < bucket.endTick ? bucket.beginTick : NEVER;
+
+        std::vector<Bucket>::iterator it = mBuckets.begin();
+        for (; it != mBuckets.end(); ++it)
+        {
+            if ( it->divisor == bucket.divisor &&
+                 it->beginTick == bucket.beginTick &&
+                 it->endTick == bucket.endTick )
+                break;
+        }
+
+        if ( it == mBuckets.end() )
+        {
+            bucket.frames.push_back( frame );
+            mBuckets.push_back( bucket );
+        }
+        else
+        {
+            it->frames.push_back( frame );
+        }
+    }
+
+    updateNextTick();
+}
+
+void LogScheduler::clear()
+{
+    mBuckets.clear();
+    mNextTick = NEVER;
+}
+
+void LogScheduler::sample(uint64_t pTick, double pTimeInSec)
+{
+    if ( pTick < mNextTick )
+        return;
+
+    for (size_t i = 0; i < mBuckets.size(); ++i)
+    {
+        Bucket& bucket = mBuckets[i];
+        if ( pTick < bucket.nextTick )
+            continue;
+
+        if ( pTick < bucket.endTick )
+        {
+            for (size_t j = 0; j < bucket.frames.size(); ++j)
+            {
+                bucket.frames[j]->insertToHeap( pTimeInSec );
+            }
+        }
+
+        // Ticks missed while paused are not logged afterwards; continue
+        // on the bucket's grid after pTick.
+        bucket.nextTick = pTick + bucket.divisor
+                - (pTick - bucket.beginTick) % bucket.divisor;
+        if ( bucket.nextTick >= bucket.endTick )
+            bucket.nextTick = NEVER;
+    }
+
+    updateNextTick();
+}
+
+size_t LogScheduler::bucketCount()
+{
+    return mBuckets.size();
+}
+
+void LogScheduler::updateNextTick()
+{
+    mNextTick = NEVER;
+    for (size_t i = 0; i < mBuckets.size(); ++i)
+    {
+        mNextTick = std::min( mNextTick, mBuckets[i].nextTick );
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * LogScheduler.h
+ *
+ *  Decides which log frames are written on a loop tick.
+ */
+
+#ifndef LOGSCHEDULER_H_
+#define LOGSCHEDULER_H_
+
+#include <vector>
+#include <cstdint>
+#include "logframe.h"
+
+/**
+ * Log frame'lerini kayit periyoduna gore gruplar (bucket). Her grubun
+ * periyodu ana dongu tick'i cinsinden tam sayi bir bolen, kayit penceresi
+ * [startTime, startTime + duration) ise tick indisleri olarak bir kez
+ * hesaplanir. Bir tick'te yalnizca zamani gelmis gruplara dokunulur.
+ *
+ * Ana frekansi tam bolmeyen log frekanslari, ana frekansi tam bolen bir
+ * alttaki frekansa yuvarlanir; boylece heap kapasitesi asilmaz.
+ */
+class LogScheduler
+{
+public:
+    LogScheduler();
+
+    /**
+     * Frame'leri ana dongu frekansina gore gruplar. Log heap'e
+     * baglandiktan sonra, dongu baslamadan once cagrilmalidir.
+     */
+    void build(const std::vector<LogFrame*>& pFrames, double pMainFreq);
+
+    void clear();
+
+    /**
+     * pTick. tick'te zamani gelmis frame'leri heap'e yazar. Tick'ler
+     * 0'dan baslar ve artarak verilmelidir.
+     */
+    void sample(uint64_t pTick, double pTimeInSec);
+
+    /** Grup sayisi */
+    size_t bucketCount();
+
+    /** Saniye cinsinden zamani tick indisine cevirir (yukari yuvarlar). */
+    static uint64_t toTick(double pTimeInSec, double pMainFreq);
+
+private:
+    struct Bucket
+    {
+        uint64_t divisor;       // kayit periyodu, tick
+        uint64_t beginTick;     // pencerenin ilk tick'i
+        uint64_t endTick;       // pencerenin son tick'inden bir sonraki
+        uint64_t nextTick;      // bir sonraki kaydin tick'i
+        std::vector<LogFrame*> frames;
+    };
+
+    void updateNextTick();
+
+    std::vector<Bucket> mBuckets;
+
+    /** Butun gruplar icinde en erken nextTick */
+    uint64_t mNextTick;
+};
+
+#endif /* LOGSCHEDULER_H_ */
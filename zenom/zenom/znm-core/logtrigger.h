@@ -0,0 +1,85 @@
+/*
+ * LogTrigger.h
+ *
+ *  Trigger condition of a log frame (oscilloscope style capture).
+ */
+
+#ifndef LOGTRIGGER_H_
+#define LOGTRIGGER_H_
+
+#include <cstdint>
+
+/**
+ * Log degiskeninin tetikleme ayarlari. Tetikleme acik ise degisken
+ * surekli kayit edilmez: heap preTrigger + postTrigger kayitlik bir ring
+ * buffer olur ve kosul saglanana kadar son preTrigger kayit tutulur.
+ * Kosul saglandiginda (tetik kaydi dahil) postTrigger kayit daha yazilir
+ * ve heap dondurulur.
+ *
+ * Kosul baska bir log degiskeninin bir elemani uzerindedir ve control
+ * process'te, kayit aninda degerlendirilir. Yapi log heap basliginda
+ * paylasildigi icin yalnizca sabit boyutlu alanlar icerir.
+ */
+struct LogTrigger
+{
+    enum Mode
+    {
+        TRIGGER_OFF = 0,
+        TRIGGER_LEVEL = 1,      // deger >= level
+        TRIGGER_RISING = 2,     // deger level'i asagidan yukari keser
+        TRIGGER_FALLING = 3,    // deger level'i yukaridan asagi keser
+        TRIGGER_WINDOW = 4      // deger [level, high] araliginin disinda
+    };
+
+    enum State
+    {
+        TRIGGER_ARMED = 0,      // pre-trigger buffer doluyor
+        TRIGGER_FIRED = 1,      // post-trigger kayitlari yaziliyor
+        TRIGGER_CAPTURED = 2    // heap donduruldu
+    };
+
+    uint32_t mode;
+    uint32_t source;        // kosulun log degiskeni (DataRepository sirasi)
+    uint32_t element;       // kaynak degiskenin elemani
+    uint32_t preTrigger;    // tetikten onceki kayit sayisi
+    uint32_t postTrigger;   // tetik kaydi dahil sonraki kayit sayisi
+    uint32_t reserved;
+    double level;           // WINDOW modunda alt sinir
+    double high;            // WINDOW modunda ust sinir
+
+    bool isEnabled() const { return mode != TRIGGER_OFF; }
+
+    /**
+     * Kosulu pValue icin degerlendirir. Kenar modlari bir onceki degeri
+     * kullanir; pHasPrevious false ise kenar tetiklenmez.
+     */
+    bool fires(double pValue, double pPrevious, bool pHasPrevious) const
+    {
+        switch ( mode )
+        {
+        case TRIGGER_LEVEL:
+            return pValue >= level;
+        case TRIGGER_RISING:
+            return pHasPrevious && pPrevious < level && pValue >= level;
+        case TRIGGER_FALLING:
+            return pHasPrevious && pPrevious > level && pValue <= level;
+        case TRIGGER_WINDOW:
+            return pValue < level || pValue > high;
+        default:
+            return false;
+        }
+    }
+
+    bool operator==(const LogTrigger& pOther) const
+    {
+        if ( !isEnabled() || !pOther.isEnabled() )
+            return isEnabled() == pOther.isEnabled();
+
+        return mode == pOther.mode && source == pOther.source &&
+               element == pOther.element && preTrigger == pOther.preTrigger &&
+               postTrigger == pOther.postTrigger && level == pOther.level &&
+               high == pOther.high;
+    }
+};
+
+#endif /* LOGTRIGGER_H_ */
@@ -6,18 +6,22 @@
  */
 
 #include "logvariable.h"
+#include "logframe.h"
 #include <iostream>
 
-LogVariable::LogVariable(double* pAddr,
+LogVariable::LogVariable(void* pAddr,
                          const std::string& pName,
                          unsigned int pRow,
                          unsigned int pCol,
-                         const std::string& pDesc)
- : Variable(pAddr, pName, pDesc, pRow, pCol)
+                         const std::string& pDesc,
+                         VariableType pType)
+ : Variable(pAddr, pName, pDesc, pRow, pCol, pType)
 {
-    mHeap = nullptr;
-    mHeapBeginAddr = nullptr;
+    mFrame = nullptr;
+    mColumn = 0;
     mMainHeapAddr = nullptr;
+    mRingCapacity = 0;
+    mTrigger = LogTrigger();
 }
 
 LogVariable::~LogVariable()
@@ -63,115 +67,141 @@ void LogVariable::setDuration(double pDuration)
     mMainHeapAddr[2] = pDuration;
 }
 
-void LogVariable::createHeap()
+unsigned int LogVariable::ringCapacity()
 {
-    // (size + Time Stamp) * frequency * duration + index
-    int heapSize = ((size() + 1) * frequency() * duration() + 1)*sizeof(double);
+    return mRingCapacity;
+}
 
-    mHeap = new SharedMem( mName, heapSize );
-    mHeapBeginAddr = (double*)mHeap->ptrToShMem();
+void LogVariable::setRingCapacity(unsigned int pCapacity)
+{
+    mRingCapacity = pCapacity;
+}
 
-	// Heap was created successfully.
-    mHeapBeginAddr[0] = 0;      // size
-    mHeapAddr = mHeapBeginAddr + 1;
+const LogTrigger& LogVariable::trigger()
+{
+    return mTrigger;
+}
 
-    mLogCounter = 0;
+void LogVariable::setTrigger(const LogTrigger& pTrigger)
+{
+    mTrigger = pTrigger;
 }
 
-void LogVariable::deleteHeap()
+int LogVariable::triggerState()
 {
+    return mFrame->triggerState();
+}
 
-    if(mHeap != nullptr){
-        delete mHeap;
-        mHeap = nullptr;
-        mHeapBeginAddr = nullptr;
-        mHeapAddr = nullptr;
-    }
+LogFrame* LogVariable::frame()
+{
+    return mFrame;
 }
 
-void LogVariable::insertToHeap(double pTimeInSec, double pMainFreq)
+void LogVariable::setFrame(LogFrame* pFrame, unsigned int pColumn)
 {
+    mFrame = pFrame;
+    mColumn = pColumn;
+}
 
-    // TODO duration ondalik sayı olmasin.
-    if( startTime() <= pTimeInSec && pTimeInSec < (startTime() + duration()) )
-	{
-        mLogCounter += frequency(); // increment counter
+bool LogVariable::isHeapValid()
+{
+    return (mFrame != nullptr) && mFrame->isHeapValid();
+}
 
-        if ( mLogCounter >= pMainFreq )
-        {
-            mLogCounter -= pMainFreq;   // reset counter;
+int LogVariable::heapSize()
+{
+    return mFrame->heapSize();
+}
 
-            unsigned int num = size();
-            std::memcpy( mHeapAddr, mVariableAddr, sizeof(double) * num );
-            // copy variable
-            mHeapAddr[num] = pTimeInSec;			// copy time stamp
+uint64_t LogVariable::heapCapacity()
+{
+    return mFrame->heapCapacity();
+}
 
-            mHeapAddr += (num + 1);	// set next address
-            ++(*mHeapBeginAddr);	// Increase index
-        }
-	}
+bool LogVariable::isRingBuffer()
+{
+    return mFrame->isRingBuffer();
 }
 
-void LogVariable::bindHeap()
+uint64_t LogVariable::writeSequence()
 {
-    // first address is size address.
-    mHeap = new SharedMem( mName );
-    mHeapBeginAddr = (double*)mHeap->ptrToShMem();
-    mHeapAddr = mHeapBeginAddr + 1;
+    return mFrame->writeSequence();
+}
 
-    mLogCounter = 0;
+uint64_t LogVariable::firstSequence()
+{
+    return mFrame->firstSequence();
 }
 
-void LogVariable::unbindHeap()
+size_t LogVariable::elementOffset(int pVariableIndex)
 {
-    if(mHeap != nullptr){
-        delete mHeap;
-        mHeap = nullptr;
-    }
+    if ( pVariableIndex == static_cast<int>(size()) )
+        return 0;
+
+    return mColumn * sizeof(double) + pVariableIndex * variableTypeSize(mType);
 }
 
-bool LogVariable::isHeapValid()
+VariableType LogVariable::elementType(int pVariableIndex)
 {
-    return (mHeap != nullptr) && heapSize();
+    return pVariableIndex == static_cast<int>(size()) ? VARIABLE_DOUBLE : mType;
 }
 
-int LogVariable::heapSize()
+double LogVariable::heapElementBySequence(uint64_t pSequence, int pVariableIndex)
+{
+    const char* record = (const char*)mFrame->recordBySequence(pSequence);
+    return variableElementToDouble( record + elementOffset(pVariableIndex),
+                                    elementType(pVariableIndex) );
+}
+
+double LogVariable::heapTimeBySequence(uint64_t pSequence)
+{
+    return mFrame->recordBySequence(pSequence)[0];
+}
+
+void LogVariable::copyHeapColumn(uint64_t pFirstSequence, uint64_t pCount,
+                                 int pVariableIndex, double* pDest, size_t pStride)
 {
-    return static_cast<int>( mHeapBeginAddr[0] );
+    mFrame->copyColumn(pFirstSequence, pCount, elementOffset(pVariableIndex),
+                       elementType(pVariableIndex), pDest, pStride);
 }
 
-double* LogVariable::heapElement(int pIndex)
+void LogVariable::copyHeapSamples(uint64_t pFirstSequence, uint64_t pCount,
+                                  int pVariableIndex, double* pDest)
 {
-    return &(mHeapBeginAddr[ pIndex * (size() + 1) + 1 ]);
+    mFrame->copySamples(pFirstSequence, pCount, elementOffset(pVariableIndex),
+                        elementType(pVariableIndex), pDest);
+}
+
+uint64_t LogVariable::firstIntactSequence(uint64_t pSequence)
+{
+    return mFrame->firstIntactSequence(pSequence);
 }
 
 double LogVariable::heapElement(int pIndex, int pVariableIndex)
 {
-	return heapElement(pIndex)[pVariableIndex];
+    return heapElementBySequence( firstSequence() + pIndex, pVariableIndex );
 }
 
 double LogVariable::heapElement(int pIndex, int pRow, int pCol)
 {
-	return heapElement(pIndex, pRow * col() + pCol);
+    return heapElement(pIndex, pRow * col() + pCol);
 }
 
-double* LogVariable::lastHeapElement()
+bool LogVariable::copyLastHeapElement(double* pElement)
 {
-	int index = heapSize() - 1;	// Last element index
-	return heapElement(index);
+    return mFrame->copyLastRecord(pElement, elementOffset(0), mType, size(),
+                                  pElement + size());
 }
 
 double LogVariable::lastHeapElement(int pVariableIndex)
 {
-	return lastHeapElement()[pVariableIndex];
+    double element = 0;
+    mFrame->copyLastRecord(&element, elementOffset(pVariableIndex),
+                           elementType(pVariableIndex), 1);
+    return element;
 }
 
 double LogVariable::lastHeapElement(int pRow, int pCol)
 {
 	return lastHeapElement(pRow * col() + pCol);
 }
-
-
-
-
-
@@ -9,18 +9,24 @@
 #define LOGVARIABLE_H_
 
 #include "variable.h"
-#include <SharedMem.h>
+#include "logtrigger.h"
 #include <chrono>
 #include <cstring>
+#include <cstdint>
+
+class LogFrame;
 
 class LogVariable: public Variable
 {
+    friend class LogFrame;
+
 public:
-    LogVariable(double* pAddr,
+    LogVariable(void* pAddr,
                 const std::string& pName,
                 unsigned int pRow = 1,
                 unsigned int pCol = 1,
-                const std::string& pDesc = "");
+                const std::string& pDesc = "",
+                VariableType pType = VARIABLE_DOUBLE);
 
 	virtual ~LogVariable();
 
@@ -62,43 +68,152 @@ public:
      */
     void setDuration(double pDuration);
 
-    // Write Data
-    void createHeap();
+    /**
+     * Ring buffer kapasitesini getirir.
+     * @return Ornek cinsinden kapasite, 0 ise heap dogrusal calisir.
+     */
+    unsigned int ringCapacity();
+
+    /**
+     * Ring buffer kapasitesini gunceller. 0'dan farkli ise heap
+     * frequency * duration yerine bu kadar ornek tutar ve dolunca
+     * en eski orneklerin uzerine yazar. Heap olusturulmadan once cagrilmalidir.
+     * @param pCapacity Ornek cinsinden kapasite
+     */
+    void setRingCapacity(unsigned int pCapacity);
 
-    void deleteHeap();
+    /** Tetikleme ayarlarini getirir. */
+    const LogTrigger& trigger();
 
-    void insertToHeap(double pTimeStamp, double pMainFreq);
+    /**
+     * Tetikleme ayarlarini gunceller. Tetikleme acik ise ring buffer
+     * kapasitesi yerine preTrigger + postTrigger kullanilir. Heap
+     * olusturulmadan once cagrilmalidir.
+     */
+    void setTrigger(const LogTrigger& pTrigger);
 
-    // Read Data
-    void bindHeap();
+    /**
+     * Tetikleme durumunu (LogTrigger::State) getirir. Tetikleme kapali
+     * ise TRIGGER_ARMED doner.
+     */
+    int triggerState();
 
-    void unbindHeap();
+    /**
+     * Degiskenin kayit edildigi grubu getirir. Heap olusturulmamis ise
+     * nullptr doner.
+     */
+    LogFrame* frame();
+
+    /**
+     * Degiskeni bir gruba baglar. LogFrame tarafindan cagrilir.
+     * @param pColumn Degiskenin grup kaydi icindeki ilk sutunu
+     */
+    void setFrame(LogFrame* pFrame, unsigned int pColumn);
+
+    /**
+     * Degiskenin grup kaydinda kapladigi 8 byte'lik sutun sayisi.
+     * Elemanlar kendi tiplerinde sikistirilir; ornegin 1000 elemanli
+     * bool degisken 125 sutun kaplar.
+     */
+    unsigned int recordColumns() { return (byteSize() + 7) / 8; }
 
+    // Read Data
     bool isHeapValid();
 
+    /**
+     * Heap'te okunabilir durumda olan ornek sayisini getirir.
+     * Ring buffer modunda en fazla kapasite kadardir.
+     */
     int heapSize();
 
-    double* heapElement(int pIndex);
+    /** Heap'in ornek cinsinden kapasitesi */
+    uint64_t heapCapacity();
+
+    /** Heap basa sariyorsa true */
+    bool isRingBuffer();
 
+    /** Simdiye kadar yazilan ornek sayisi */
+    uint64_t writeSequence();
+
+    /** Heap'te hala bulunan en eski ornegin sequence numarasi */
+    uint64_t firstSequence();
+
+    /**
+     * Sequence numarasi verilen ornegin pVariableIndex. elemanini double
+     * olarak getirir. pVariableIndex size() ise zaman etiketi doner.
+     * Sequence numarasi [firstSequence(), writeSequence()) araliginda
+     * olmalidir.
+     */
+    double heapElementBySequence(uint64_t pSequence, int pVariableIndex);
+
+    /** Sequence numarasi verilen ornegin zaman etiketini getirir. */
+    double heapTimeBySequence(uint64_t pSequence);
+
+    /**
+     * [pFirstSequence, pFirstSequence + pCount) araligindaki orneklerin
+     * pVariableIndex. elemanini pDest'e pStride double aralikla tek
+     * gecisle kopyalar. pVariableIndex size() ise zaman etiketleri
+     * kopyalanir. Aralik [firstSequence(), writeSequence()) icinde
+     * olmalidir.
+     */
+    void copyHeapColumn(uint64_t pFirstSequence, uint64_t pCount,
+                        int pVariableIndex, double* pDest, size_t pStride = 1);
+
+    /**
+     * copyHeapColumn gibi, fakat pDest'e (zaman etiketi, deger) ciftleri
+     * yazar; pDest 2 * pCount uzunlugunda olmalidir.
+     */
+    void copyHeapSamples(uint64_t pFirstSequence, uint64_t pCount,
+                         int pVariableIndex, double* pDest);
+
+    /**
+     * copyHeapColumn veya copyHeapSamples ile pSequence'tan itibaren
+     * kopyalanan orneklerden ilk saglam olaninin sequence numarasi.
+     * Ring buffer'da ondan onceki ornekler kopyalanirken ezilmistir.
+     */
+    uint64_t firstIntactSequence(uint64_t pSequence);
+
+    /**
+     * Heap'teki en eski ornekten itibaren pIndex. ornegin elemanini
+     * getirir. pVariableIndex size() ise ornegin zaman etiketini getirir.
+     */
     double heapElement(int pIndex, int pVariableIndex);
 
     double heapElement(int pIndex, int pRow, int pCol);
 
-    double* lastHeapElement();
+    /**
+     * En son yazilan ornegin tutarli bir kopyasini alir (size() deger ve
+     * zaman etiketi). RT yazici hicbir zaman beklemez. Okuyucu, kopyaladigi
+     * slotun kopyalama sirasinda ezilmedigini writeSequence ile dogrular;
+     * ornek ancak yazici butun heap'i bir tur dolasirsa tekrar okunur.
+     * @param pElement (size() + 1) uzunlugunda hedef dizi
+     * @return heap bos ise false
+     */
+    bool copyLastHeapElement(double* pElement);
 
+    /**
+     * pVariableIndex size() ise son ornegin zaman etiketini getirir.
+     */
     double lastHeapElement(int pVariableIndex);
 
     double lastHeapElement(int pRow, int pCol);
 
 protected:
 
-    SharedMem* mHeap;
-    double* mHeapBeginAddr;
-    double* mHeapAddr;
+    /** pVariableIndex. elemanin kayit basindan byte cinsinden uzakligi */
+    size_t elementOffset(int pVariableIndex);
+
+    /** pVariableIndex. elemanin tipi, zaman etiketi double'dir */
+    VariableType elementType(int pVariableIndex);
+
+    LogFrame* mFrame;
+    unsigned int mColumn;
 
     double* mMainHeapAddr;
 
-    double mLogCounter;
+    unsigned int mRingCapacity;
+
+    LogTrigger mTrigger;
 };
 
 #endif /* LOGVARIABLE_H_ */
@@ -10,13 +10,15 @@
 //==============================================================================
 // Variable::Variable
 //==============================================================================
-Variable::Variable(double* pAddr,
+Variable::Variable(void* pAddr,
                    const std::string& pName,
                    const std::string& pDesc ,
                    unsigned int pRow ,
-                   unsigned int pCol)
+                   unsigned int pCol,
+                   VariableType pType)
 {
     mVariableAddr = pAddr;
+    mType = pType;
     mName = pName;
     mDescription = pDesc;
     mRow = pRow;
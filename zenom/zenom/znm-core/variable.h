@@ -9,16 +9,75 @@
 #define VARIABLE_H_
 
 #include <string>
+#include <cstring>
+#include <cstdint>
 #include "znm-core_global.h"
 
+/** Degisken elemanlarinin tipi */
+enum VariableType
+{
+    VARIABLE_DOUBLE = 0,
+    VARIABLE_FLOAT = 1,
+    VARIABLE_INT32 = 2,
+    VARIABLE_INT64 = 3,
+    VARIABLE_BOOL = 4
+};
+
+/** C++ tipinin VariableType karsiligi; desteklenmeyen tipler derlenmez. */
+template <typename T> struct VariableTypeOf;
+template <> struct VariableTypeOf<double>  { static const VariableType value = VARIABLE_DOUBLE; };
+template <> struct VariableTypeOf<float>   { static const VariableType value = VARIABLE_FLOAT; };
+template <> struct VariableTypeOf<int32_t> { static const VariableType value = VARIABLE_INT32; };
+template <> struct VariableTypeOf<int64_t> { static const VariableType value = VARIABLE_INT64; };
+template <> struct VariableTypeOf<bool>    { static const VariableType value = VARIABLE_BOOL; };
+
+/** Bir elemanin byte cinsinden boyutu */
+inline unsigned int variableTypeSize(VariableType pType)
+{
+    switch ( pType )
+    {
+    case VARIABLE_FLOAT: return sizeof(float);
+    case VARIABLE_INT32: return sizeof(int32_t);
+    case VARIABLE_BOOL: return sizeof(bool);
+    default: return 8;
+    }
+}
+
+/** pElement adresindeki pType tipindeki elemani double olarak okur. */
+inline double variableElementToDouble(const void* pElement, VariableType pType)
+{
+    switch ( pType )
+    {
+    case VARIABLE_FLOAT: { float v; std::memcpy(&v, pElement, sizeof(v)); return v; }
+    case VARIABLE_INT32: { int32_t v; std::memcpy(&v, pElement, sizeof(v)); return v; }
+    case VARIABLE_INT64: { int64_t v; std::memcpy(&v, pElement, sizeof(v)); return (double)v; }
+    case VARIABLE_BOOL: return *(const unsigned char*)pElement ? 1.0 : 0.0;
+    default: { double v; std::memcpy(&v, pElement, sizeof(v)); return v; }
+    }
+}
+
+/** pValue'yu pType tipine cevirip pElement adresine yazar. */
+inline void variableElementFromDouble(double pValue, void* pElement, VariableType pType)
+{
+    switch ( pType )
+    {
+    case VARIABLE_FLOAT: { float v = (float)pValue; std::memcpy(pElement, &v, sizeof(v)); break; }
+    case VARIABLE_INT32: { int32_t v = (int32_t)pValue; std::memcpy(pElement, &v, sizeof(v)); break; }
+    case VARIABLE_INT64: { int64_t v = (int64_t)pValue; std::memcpy(pElement, &v, sizeof(v)); break; }
+    case VARIABLE_BOOL: { bool v = pValue != 0; std::memcpy(pElement, &v, sizeof(v)); break; }
+    default: std::memcpy(pElement, &pValue, sizeof(pValue)); break;
+    }
+}
+
 class Variable
 {
 public:
-    Variable(double* pAddr,
+    Variable(void* pAddr,
              const std::string& pName,
              const std::string& pDesc,
              unsigned int pRow,
-             unsigned int pCol);
+             unsigned int pCol,
+             VariableType pType = VARIABLE_DOUBLE);
 
 	virtual ~Variable();
 
@@ -58,10 +117,25 @@ public:
 	 */
     inline unsigned int col(){ return mCol; }
 
+	/**
+	 * Gets element type
+	 * @return type
+	 */
+    inline VariableType type(){ return mType; }
+
+	/**
+	 * Gets variable's size in bytes
+	 * @return size() * element size
+	 */
+    inline unsigned int byteSize(){ return size() * variableTypeSize(mType); }
+
 protected:
 
 	/** Degisken adresi */
-    double* mVariableAddr;
+    void* mVariableAddr;
+
+	/** Degisken elemanlarinin tipi */
+    VariableType mType;
 
 	/** Degisken ismi */
 	std::string mName;
@@ -23,6 +23,10 @@ DEFINES += ZNMCORE_LIBRARY
 SOURCES += \
     variable.cpp \
     logvariable.cpp \
+    logframe.cpp \
+    logscheduler.cpp \
+    logfilereader.cpp \
+    logcodec.cpp \
     controlvariable.cpp \
     datarepository.cpp
 
@@ -30,7 +34,14 @@ HEADERS +=\
         znm-core_global.h \
     variable.h \
     logvariable.h \
+    logframe.h \
+    logtrigger.h \
+    logscheduler.h \
+    logfile.h \
+    logfilereader.h \
+    logcodec.h \
     controlvariable.h \
+    controlspan.h \
     datarepository.h
 
 # Zenom Tools Library
@@ -94,7 +94,7 @@ ssize_t MsgQueue::receive(void *buf, size_t size,  struct timespec *timeout)
         bytesReceived = mq_receive(mMqfd, (char*)buf, size, nullptr);
     else
         bytesReceived = mq_timedreceive(mMqfd,(char*)buf, size, nullptr,timeout);
-    if (bytesReceived == -1 && errno != ETIMEDOUT)
+    if (bytesReceived == -1 && errno != ETIMEDOUT && errno != EINTR)
         throw std::system_error(errno, std::system_category(),
                     mName +" MsgQueue::receive");
     return bytesReceived;
@@ -89,8 +89,8 @@ class MsgQueue
      * @param buf
      * @param size
      * @param timeout if nullptr, it will be a blocking call, otherwise
-     * it will try to receive until timeout occurs
-     * @return
+     * it will try to receive until timeout occurs (absolute CLOCK_REALTIME)
+     * @return -1 if the timeout occurs or a signal interrupts the call
      */
     ssize_t receive(void *buf, size_t size,  struct timespec *timeout = nullptr);
 
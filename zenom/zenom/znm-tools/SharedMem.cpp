@@ -122,6 +122,11 @@ void *SharedMem::ptrToShMem()
     return mPtrToShMem;
 }
 
+size_t SharedMem::size()
+{
+    return mSize;
+}
+
 bool SharedMem::isBinded()
 {
     return !mIsCreated;
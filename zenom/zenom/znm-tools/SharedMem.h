@@ -73,6 +73,13 @@ public:
      */
     void *ptrToShMem();
 
+    /**
+     * @brief size
+     * @return size of the mapping in bytes, taken from fstat when the
+     * shared memory is binded
+     */
+    size_t size();
+
     /**
      * @brief isBinded
      * @return true if binded, false otherwise
@@ -51,6 +51,9 @@ void TaskXn::runTask()
     }
     mWishToRun = true;
     mTask = std::thread(&TaskXn::taskFunction, this);
+    if(mPriority == normalPriority())
+        return;
+
     // Give RT priority to task
     sched_param sch;
     sch.__sched_priority = mPriority;
@@ -102,6 +105,12 @@ int TaskXn::minPriority()
     return sched_get_priority_min(SCHED_FIFO);
 }
 
+int TaskXn::normalPriority()
+{
+    // SCHED_FIFO priorities start at 1
+    return 0;
+}
+
 void TaskXn::requestPeriodicTaskTermination()
 {
     mWishToRun = false;
@@ -81,6 +81,13 @@ class TaskXn
 
     static int minPriority();
 
+    /**
+     * @brief normalPriority a task created with this priority is not
+     * given a real-time priority and runs as a normal (SCHED_OTHER)
+     * thread. Use it for tasks that block on I/O.
+     */
+    static int normalPriority();
+
     void requestPeriodicTaskTermination();
 
  protected: